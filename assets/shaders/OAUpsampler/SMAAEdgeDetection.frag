@@ -58,6 +58,12 @@ layout(std140, binding = 1) uniform SMAASettings
 	uint		maxSearchStepsDiag;
 	uint		cornerRounding;
     uint        edgeDetectionMode;
+	float		predicationThreshold;
+	float		predicationScale;
+	float		predicationStrength;
+	uint		usePredication;
+	uint		sampleIndex;
+	uint		subsampleIndex; //0 = SMAA 1x, 1 and 2 = which S2x sample this pass is for
 };
 
 layout(binding = 0) uniform sampler2D colorTexture;
@@ -79,6 +85,20 @@ float3 SMAAGatherNeighbours(float2 texcoord,
     #endif
 }
 
+/**
+ * Adjusts the threshold by means of predication.
+ * where depth has an edge the threshold drops, everywhere else it goes up by predicationScale,
+ * so texture detail on a flat surface stops showing up as geometric edges
+ */
+float2 SMAACalculatePredicatedThreshold(float2 texcoord,
+                                        float4 offset[3],
+                                        SMAATexture2D(predicationTex)) {
+    float3 neighbours = SMAAGatherNeighbours(texcoord, offset, SMAATexturePass2D(predicationTex));
+    float2 delta = abs(neighbours.xx - neighbours.yz);
+    float2 edges = step(predicationThreshold, delta);
+    return predicationScale * inThreshold * (1.0 - predicationStrength * edges);
+}
+
 //-----------------------------------------------------------------------------
 // Edge Detection Pixel Shaders (First Pass)
 
@@ -90,17 +110,11 @@ float3 SMAAGatherNeighbours(float2 texcoord,
  */
 float2 SMAALumaEdgeDetectionPS(float2 texcoord,
                                float4 offset[3],
-                               SMAATexture2D(colorTex)
-                               #if SMAA_PREDICATION
-                               , SMAATexture2D(predicationTex)
-                               #endif
-                               ) {
+                               SMAATexture2D(colorTex),
+                               SMAATexture2D(predicationTex)) {
     // Calculate the threshold:
-    #if SMAA_PREDICATION
-    float2 threshold = SMAACalculatePredicatedThreshold(texcoord, offset, SMAATexturePass2D(predicationTex));
-    #else
-    float2 threshold = float2(inThreshold, inThreshold);
-    #endif
+    float2 threshold = (usePredication != 0) ? SMAACalculatePredicatedThreshold(texcoord, offset, SMAATexturePass2D(predicationTex)) :
+        float2(inThreshold, inThreshold);
 
     // Calculate lumas:
     float3 weights = float3(0.2126, 0.7152, 0.0722);
@@ -149,17 +163,11 @@ float2 SMAALumaEdgeDetectionPS(float2 texcoord,
  */
 float2 SMAAColorEdgeDetectionPS(float2 texcoord,
                                 float4 offset[3],
-                                SMAATexture2D(colorTex)
-                                #if SMAA_PREDICATION
-                                , SMAATexture2D(predicationTex)
-                                #endif
-                                ) {
+                                SMAATexture2D(colorTex),
+                                SMAATexture2D(predicationTex)) {
     // Calculate the threshold:
-    #if SMAA_PREDICATION
-    float2 threshold = SMAACalculatePredicatedThreshold(texcoord, offset, predicationTex);
-    #else
-    float2 threshold = float2(inThreshold, inThreshold);
-    #endif
+    float2 threshold = (usePredication != 0) ? SMAACalculatePredicatedThreshold(texcoord, offset, SMAATexturePass2D(predicationTex)) :
+        float2(inThreshold, inThreshold);
 
     // Calculate color deltas:
     float4 delta;
@@ -231,10 +239,10 @@ void main()
 {
     switch (edgeDetectionMode) {
         case 0: // Luma Edge Detection
-            outColor = vec4(SMAALumaEdgeDetectionPS(inBlock.uv, inEdge.offset, colorTexture), 0, 1);
+            outColor = vec4(SMAALumaEdgeDetectionPS(inBlock.uv, inEdge.offset, colorTexture, depthTexture), 0, 1);
             break;
         case 1: // Color Edge Detection
-            outColor = vec4(SMAAColorEdgeDetectionPS(inBlock.uv, inEdge.offset, colorTexture), 0, 1);
+            outColor = vec4(SMAAColorEdgeDetectionPS(inBlock.uv, inEdge.offset, colorTexture, depthTexture), 0, 1);
             break;
         case 2: // Depth Edge Detection
             outColor = vec4(SMAADepthEdgeDetectionPS(inBlock.uv, inEdge.offset, depthTexture), 0, 1);
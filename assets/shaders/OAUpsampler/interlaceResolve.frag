@@ -0,0 +1,105 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+layout(std140, binding = 4) uniform upcsaleSettings
+{
+	vec4 metrics; //Z and W are output resolution, xy = rcp(zw). calculate rcp on c++ side
+	vec2 resolutionScale;
+	float blendingFactor;
+	float reproSharpness;
+	float spatialFlickerTime;
+	float timeMax;
+	float timeMin;
+	float edgeThreshold;
+	vec4 jitter; //xy = this frame's offset in scaled pixels
+	mat4 reprojection; //current clip space to last frame's, without jitter
+	uint isHistoryValid;
+	uint hasVelocity;
+	uint interlaceParity; //which lines along interlaceAxis this frame shaded
+	uint interlaceAxis; //0 = columns, 1 = rows
+};
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out float outDepth;
+
+layout(binding = 0) uniform sampler2D currentTexture; //this frame's lines, half size along interlaceAxis
+layout(binding = 1) uniform sampler2D historyTexture; //last frame's output, full resolution
+layout(binding = 2) uniform sampler2D depthTexture; //this frame's lines
+layout(binding = 3) uniform sampler2D velocityTexture; //this frame's lines, UV units
+layout(binding = 4) uniform sampler2D historyDepthTexture; //depth that went with last frame's output
+
+//how far history depth can sit outside the two lines either side of it and still count as the same surface
+const float depthTolerance = 0.002;
+
+void main()
+{
+	ivec2 fullPixel = ivec2(gl_FragCoord.xy);
+	ivec2 scaledSize = textureSize(currentTexture, 0);
+	int line = fullPixel[interlaceAxis];
+
+	ivec2 scaledPixel = fullPixel;
+	scaledPixel[interlaceAxis] = line / 2;
+	scaledPixel = min(scaledPixel, scaledSize - 1);
+
+	//shaded this frame, copy it straight through
+	if((line & 1) == int(interlaceParity) && line / 2 < scaledSize[interlaceAxis])
+	{
+		outColor = texelFetch(currentTexture, scaledPixel, 0);
+		outDepth = texelFetch(depthTexture, scaledPixel, 0).r;
+		return;
+	}
+
+	//not shaded this frame. the lines either side of it were
+	ivec2 before = scaledPixel;
+	ivec2 after = scaledPixel;
+	before[interlaceAxis] = clamp((line - 1 - int(interlaceParity)) / 2, 0, scaledSize[interlaceAxis] - 1);
+	after[interlaceAxis] = clamp((line + 1 - int(interlaceParity)) / 2, 0, scaledSize[interlaceAxis] - 1);
+
+	vec4 colorBefore = texelFetch(currentTexture, before, 0);
+	vec4 colorAfter = texelFetch(currentTexture, after, 0);
+	float depthBefore = texelFetch(depthTexture, before, 0).r;
+	float depthAfter = texelFetch(depthTexture, after, 0).r;
+
+	//halfway between two shaded lines is exactly what the bilinear SMAA upscale would give us
+	vec4 fallbackColor = mix(colorBefore, colorAfter, 0.5);
+	float fallbackDepth = mix(depthBefore, depthAfter, 0.5);
+
+	vec2 historyUV;
+	if(hasVelocity != 0)
+	{
+		vec2 velocity = 0.5 * (texelFetch(velocityTexture, before, 0).xy + texelFetch(velocityTexture, after, 0).xy);
+		historyUV = inBlock.uv - velocity;
+	}
+	else
+	{
+		vec4 previous = reprojection * vec4(inBlock.uv * 2.0 - 1.0, fallbackDepth * 2.0 - 1.0, 1.0);
+		historyUV = (previous.xy / previous.w) * 0.5 + 0.5;
+	}
+
+	vec4 history = texture(historyTexture, historyUV);
+	float historyDepth = texture(historyDepthTexture, historyUV).r;
+
+	//history has to be on the same surface as the lines around it and not far off their colour
+	bool isInside = all(greaterThanEqual(historyUV, vec2(0.0))) && all(lessThanEqual(historyUV, vec2(1.0)));
+	bool isDepthValid = historyDepth >= min(depthBefore, depthAfter) - depthTolerance && historyDepth <= max(depthBefore, depthAfter) + depthTolerance;
+	vec3 minColor = min(colorBefore.rgb, colorAfter.rgb) - edgeThreshold;
+	vec3 maxColor = max(colorBefore.rgb, colorAfter.rgb) + edgeThreshold;
+	bool isColorValid = all(greaterThanEqual(history.rgb, minColor)) && all(lessThanEqual(history.rgb, maxColor));
+
+	if(isHistoryValid != 0 && isInside && isDepthValid && isColorValid)
+	{
+		outColor = history;
+		outDepth = historyDepth;
+	}
+	else
+	{
+		outColor = fallbackColor;
+		outDepth = fallbackDepth;
+	}
+}
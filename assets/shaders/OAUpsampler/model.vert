@@ -1,4 +1,5 @@
 #version 450
+#extension GL_ARB_shader_draw_parameters : require
 
 layout (location = 0) in vec4 position;
 layout (location = 1) in vec4 normal;
@@ -13,6 +14,19 @@ out defaultBlock
 	vec2		uv;
 } outBlock;
 
+//where this vertex is now and where it was last frame, the fragment shader turns the difference into a velocity
+out motionBlock
+{
+	vec4		currentPosition;
+	vec4		previousPosition;
+} outMotion;
+
+//which draw of the multi draw this is, used to look up the material
+flat out uint drawIndex;
+
+//gl_DrawIDARB restarts for every batch, this is where the batch starts
+uniform uint drawOffset;
+
 layout(std140, binding = 0) uniform defaultSettings
 {
 	mat4		projection;
@@ -24,6 +38,10 @@ layout(std140, binding = 0) uniform defaultSettings
 	float		totalTime;
 	float 		framesPerSecond;
 	uint 		totalFrames;
+	mat4		previousProjection;
+	mat4		previousView;
+	mat4		previousTranslation;
+	vec2		projectionJitter;
 };
 
 void main()
@@ -32,6 +50,10 @@ void main()
 	outBlock.position = projection * view * translation * position;
 	outBlock.uv = uv;
 	outBlock.normal = normal;
+	drawIndex = drawOffset + uint(gl_DrawIDARB);
+
+	outMotion.currentPosition = outBlock.position;
+	outMotion.previousPosition = previousProjection * previousView * previousTranslation * position;
 	
 	gl_Position = outBlock.position;
 }
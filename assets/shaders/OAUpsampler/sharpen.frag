@@ -0,0 +1,62 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+layout(std140, binding = 4) uniform upcsaleSettings
+{
+	vec4 metrics; //Z and W are output resolution, xy = rcp(zw). calculate rcp on c++ side
+	vec2 resolutionScale;
+	float blendingFactor;
+	float reproSharpness;
+	float spatialFlickerTime;
+	float timeMax;
+	float timeMin;
+	float edgeThreshold;
+	vec4 jitter; //xy = this frame's offset in scaled pixels
+	mat4 reprojection; //current clip space to last frame's, without jitter
+	uint isHistoryValid;
+	uint hasVelocity;
+	uint interlaceParity; //which lines along interlaceAxis this frame shaded
+	uint interlaceAxis; //0 = columns, 1 = rows
+	float sharpness; //0 = none, 1 = as much as CAS will give
+	uint upscaleAxis; //the axis the kernel runs along, the other one is left to the bilinear filter
+	uint numTaps;
+	float filterScale;
+};
+
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 0) uniform sampler2D upscaledTexture; //full resolution
+
+vec3 Fetch(ivec2 pixel)
+{
+	ivec2 size = textureSize(upscaledTexture, 0);
+	return texelFetch(upscaledTexture, clamp(pixel, ivec2(0), size - 1), 0).rgb;
+}
+
+//contrast adaptive sharpening. a negative lobe on the four neighbours, scaled back wherever the
+//neighbourhood is already close to clipping so flat areas get sharpened and edges don't get halos
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	vec3 centre = Fetch(pixel);
+	vec3 up = Fetch(pixel + ivec2(0, 1));
+	vec3 down = Fetch(pixel + ivec2(0, -1));
+	vec3 left = Fetch(pixel + ivec2(-1, 0));
+	vec3 right = Fetch(pixel + ivec2(1, 0));
+
+	vec3 minColor = min(centre, min(min(up, down), min(left, right)));
+	vec3 maxColor = max(centre, max(max(up, down), max(left, right)));
+
+	//how much headroom there is before the result would clip, per channel
+	vec3 amount = sqrt(clamp(min(minColor, 2.0 - maxColor) / max(maxColor, 1e-4), 0.0, 1.0));
+	vec3 weight = amount * (-1.0 / mix(8.0, 5.0, clamp(sharpness, 0.0, 1.0)));
+
+	vec3 result = ((up + down + left + right) * weight + centre) / (1.0 + 4.0 * weight);
+	outColor = vec4(clamp(result, 0.0, 1.0), texelFetch(upscaledTexture, pixel, 0).a);
+}
@@ -0,0 +1,105 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+layout(std140, binding = 4) uniform upcsaleSettings
+{
+	vec4 metrics; //Z and W are output resolution, xy = rcp(zw). calculate rcp on c++ side
+	vec2 resolutionScale;
+	float blendingFactor;
+	float reproSharpness;
+	float spatialFlickerTime;
+	float timeMax;
+	float timeMin;
+	float edgeThreshold;
+	vec4 jitter; //xy = this frame's offset in scaled pixels
+	mat4 reprojection; //current clip space to last frame's, without jitter
+	uint isHistoryValid;
+	uint hasVelocity;
+	uint interlaceParity; //which lines along interlaceAxis this frame shaded
+	uint interlaceAxis; //0 = columns, 1 = rows
+	float sharpness; //0 = none, 1 = as much as CAS will give
+	uint upscaleAxis; //the axis the kernel runs along, the other one is left to the bilinear filter
+	uint numTaps;
+	float filterScale;
+};
+
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 0) uniform sampler2D sourceTexture; //SMAA output at the scaled resolution
+layout(binding = 1) uniform sampler2D weightTexture; //x = tap, y = phase, rows sum to 1
+
+const vec3 lumaWeights = vec3(0.2126, 0.7152, 0.0722);
+
+float Luma(ivec2 pixel)
+{
+	ivec2 size = textureSize(sourceTexture, 0);
+	return dot(texelFetch(sourceTexture, clamp(pixel, ivec2(0), size - 1), 0).rgb, lumaWeights);
+}
+
+void main()
+{
+	vec2 sourceSize = vec2(textureSize(sourceTexture, 0));
+	int axis = int(upscaleAxis);
+	int other = 1 - axis;
+
+	//where this output pixel lands in the source, in texels with centres on the integers
+	vec2 sourcePosition = inBlock.uv * sourceSize - 0.5;
+	float base = floor(sourcePosition[axis]);
+	float phase = sourcePosition[axis] - base;
+
+	//sobel around the nearest texel. along an edge the taps follow the edge instead of cutting across it,
+	//which is what keeps diagonals from stair stepping when the kernel only runs along one axis
+	ivec2 centre = ivec2(floor(sourcePosition + 0.5));
+	float topLeft = Luma(centre + ivec2(-1, 1));
+	float top = Luma(centre + ivec2(0, 1));
+	float topRight = Luma(centre + ivec2(1, 1));
+	float left = Luma(centre + ivec2(-1, 0));
+	float right = Luma(centre + ivec2(1, 0));
+	float bottomLeft = Luma(centre + ivec2(-1, -1));
+	float bottom = Luma(centre + ivec2(0, -1));
+	float bottomRight = Luma(centre + ivec2(1, -1));
+	vec2 gradient = vec2((topRight + 2.0 * right + bottomRight) - (topLeft + 2.0 * left + bottomLeft),
+		(topLeft + 2.0 * top + topRight) - (bottomLeft + 2.0 * bottom + bottomRight));
+
+	//tangent is the gradient turned a quarter. steer by how far it leans off the kernel axis, no more than a texel per tap
+	vec2 tangent = vec2(-gradient.y, gradient.x);
+	float edgeStrength = smoothstep(edgeThreshold * 0.5, edgeThreshold, length(gradient));
+	float slope = (abs(tangent[axis]) > 1e-4) ? clamp(tangent[other] / tangent[axis], -1.0, 1.0) * edgeStrength : 0.0;
+
+	int numPhases = textureSize(weightTexture, 0).y;
+	int phaseRow = clamp(int(phase * float(numPhases) + 0.5), 0, numPhases - 1);
+	int firstTap = 1 - int(numTaps) / 2;
+
+	vec4 sum = vec4(0);
+	float weightSum = 0.0;
+	vec4 minColor = vec4(1e9);
+	vec4 maxColor = vec4(-1e9);
+	for(int tap = 0; tap < int(numTaps); tap++)
+	{
+		float offset = float(firstTap + tap);
+		float weight = texelFetch(weightTexture, ivec2(tap, phaseRow), 0).r;
+
+		vec2 samplePosition = sourcePosition;
+		samplePosition[axis] = base + offset;
+		samplePosition[other] += (offset - phase) * slope;
+
+		vec4 color = texture(sourceTexture, (samplePosition + 0.5) / sourceSize);
+		sum += color * weight;
+		weightSum += weight;
+
+		//the two taps either side bound the result, lanczos lobes would ring past them otherwise
+		if(abs(offset - phase) < 1.0)
+		{
+			minColor = min(minColor, color);
+			maxColor = max(maxColor, color);
+		}
+	}
+
+	outColor = clamp(sum / max(weightSum, 1e-4), minColor, maxColor);
+}
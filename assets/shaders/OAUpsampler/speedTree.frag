@@ -7,7 +7,17 @@ in defaultBlock
 	vec2		uv;
 } inBlock;
 
+flat in uint drawIndex;
+
+in motionBlock
+{
+	vec4		currentPosition;
+	vec4		previousPosition;
+} inMotion;
+
 layout(location = 0) out vec4 outColor;
+//screen space motion since last frame in UV units. only lands anywhere when the velocity attachment is bound
+layout(location = 1) out vec2 outVelocity;
 
 layout(std140, binding = 0) uniform defaultSettings
 {
@@ -20,6 +30,25 @@ layout(std140, binding = 0) uniform defaultSettings
 	float		totalTime;
 	float 		framesPerSecond;
 	uint		totalFrames;
+	mat4		previousProjection;
+	mat4		previousView;
+	mat4		previousTranslation;
+	vec2		projectionJitter;
+};
+
+struct material_t
+{
+	vec4		diffuse;
+	vec4		specular;
+	vec4		ambient;
+	vec4		emissive;
+	uvec4		flags; //x = has diffuse map
+	uvec4		textureHandles; //xy = bindless diffuse handle, only set on the bindless path
+};
+
+layout(std430, binding = 0) readonly buffer materialSettings
+{
+	material_t	materials[];
 };
 
 layout(binding = 0) uniform sampler2D diffuse;
@@ -46,9 +75,15 @@ vec3 srgbToLinear(vec3 srgb) {
 void main()
 {
 	//clamp the alpha down hard. if alpha is less than 0.1, clamp it to 0
-	vec4 col =  texture(diffuse, inBlock.uv);
+	material_t material = materials[drawIndex];
+	vec4 col = (material.flags.x != 0) ? texture(diffuse, inBlock.uv) : material.diffuse;
 
 	// (xchen) gamma to linear sRGB transformation
 	outColor.xyz = col.xyz;// srgbToLinear(col.xyz);
 	outColor.a = col.a;
+
+	//the jitter isn't motion, take it back out of the current position
+	vec2 currentNDC = inMotion.currentPosition.xy / inMotion.currentPosition.w - projectionJitter;
+	vec2 previousNDC = inMotion.previousPosition.xy / inMotion.previousPosition.w;
+	outVelocity = (currentNDC - previousNDC) * 0.5;
 }
\ No newline at end of file
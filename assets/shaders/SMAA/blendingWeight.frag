@@ -58,6 +58,13 @@ layout(std140, binding = 1) uniform SMAASettings
 	uint		maxSearchSteps;
 	uint		maxSearchStepsDiag;
 	uint		cornerRounding;
+    uint        edgeDetectionMode;
+	float		predicationThreshold;
+	float		predicationScale;
+	float		predicationStrength;
+	uint		usePredication;
+	uint		sampleIndex;
+	uint		subsampleIndex; //0 = SMAA 1x, 1 and 2 = which S2x sample this pass is for
 };
 
 
@@ -515,12 +522,12 @@ void main()
 {
 	vec4 indices[3] = 
 	{
+        vec4(0, 0, 0, 0),
 		vec4(1, 1, 1, 0),
-		vec4(2, 2, 2, 0),
-        vec4(0, 0, 0, 0)
+		vec4(2, 2, 2, 0)
 	};
 
-	outColor = SMAABlendingWeightCalculationPS(inBlock.uv, inBlend.pixcoord, inBlend.offset, edgesTexture, areaTexture, searchTexture, indices[2]);
+	outColor = SMAABlendingWeightCalculationPS(inBlock.uv, inBlend.pixcoord, inBlend.offset, edgesTexture, areaTexture, searchTexture, indices[min(subsampleIndex, 2u)]);
 
     //outColor = vec4(inBlend.offset[0].xy, inBlend.offset[0].zw);
 }
@@ -0,0 +1,44 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+layout(std140, binding = 1) uniform SMAASettings
+{
+    vec4 		rtMetrics;
+	float		inThreshold;
+	float		contrastAdaptationFactor;
+	uint		maxSearchSteps;
+	uint		maxSearchStepsDiag;
+	uint		cornerRounding;
+    uint        edgeDetectionMode;
+	float		predicationThreshold;
+	float		predicationScale;
+	float		predicationStrength;
+	uint		usePredication;
+	uint		sampleIndex; //the multisample sample this pass pulls out
+	uint		subsampleIndex; //0 = SMAA 1x, 1 and 2 = which S2x sample this pass is for
+};
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec2 outVelocity;
+
+layout(binding = 0) uniform sampler2DMS colorTexture;
+layout(binding = 1) uniform sampler2DMS depthTexture;
+layout(binding = 2) uniform sampler2DMS velocityTexture; //only written out when the geometry buffer has velocity
+
+//copies one sample of the multisampled geometry pass into the regular geometry buffer, depth included,
+//so the SMAA passes can run on it as if it were a 1x image
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	int sampleID = int(sampleIndex);
+
+	outColor = texelFetch(colorTexture, pixel, sampleID);
+	outVelocity = texelFetch(velocityTexture, pixel, sampleID).xy;
+	gl_FragDepth = texelFetch(depthTexture, pixel, sampleID).r;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#version 450
+#define SMAATexture2D(tex) sampler2D tex
+#define SMAATexturePass2D(tex) tex
+#define SMAASampleLevelZero(tex, coord) textureLod(tex, coord, 0.0)
+#define SMAASampleLevelZeroPoint(tex, coord) textureLod(tex, coord, 0.0)
+#define SMAASampleLevelZeroOffset(tex, coord, offset) textureLodOffset(tex, coord, 0.0, offset)
+#define SMAASample(tex, coord) texture(tex, coord)
+#define SMAASamplePoint(tex, coord) texture(tex, coord)
+#define SMAASampleOffset(tex, coord, offset) texture(tex, coord, offset)
+#define SMAA_FLATTEN
+#define SMAA_BRANCH
+#define lerp(a, b, t) mix(a, b, t)
+#define saturate(a) clamp(a, 0.0, 1.0)
+#define mad(a, b, c) fma(a, b, c)
+#define SMAAGather(tex, coord) textureGather(tex, coord)
+#define float2 vec2
+#define float3 vec3
+#define float4 vec4
+#define int2 ivec2
+#define int3 ivec3
+#define int4 ivec4
+#define bool2 bvec2
+#define bool3 bvec3
+#define bool4 bvec4
+
+layout (location = 0) in vec4 position;
+layout (location = 1) in vec2 uv;
+
+out defaultBlock
+{
+	noperspective vec4 position;
+	noperspective vec2 uv;
+} outBlock;
+
+out blendBlock
+{
+	noperspective vec4 offset[3];
+	noperspective vec2 pixcoord;
+} outBlend;
+
+layout(std140, binding = 0) uniform defaultSettings
+{
+	mat4		projection;
+	mat4		view;
+	mat4		translation;
+	vec2		resolution;
+	vec2		mousePosition;
+	float		deltaTime;
+	float		totalTime;
+	float 		framesPerSecond;
+	uint		totalFrames;
+};
+
+layout(std140, binding = 1) uniform SMAASettings
+{
+	vec4 		rtMetrics;
+	float		inThreshold;
+	float		contrastAdaptationFactor;
+	uint		maxSearchSteps;
+	uint		maxSearchStepsDiag;
+	uint		cornerRounding;
+	uint        edgeDetectionMode;
+};
+
+/**
+ * Blend Weight Calculation Vertex Shader
+ */
+void SMAABlendingWeightCalculationVS(float2 texcoord,
+                                     out float2 pixcoord,
+                                     out float4 offset[3]) {
+    pixcoord = texcoord * rtMetrics.zw;
+
+    // We will use these offsets for the searches later on (see @PSEUDO_GATHER4):
+    offset[0] = mad(rtMetrics.xyxy, float4(-0.25, -0.125,  1.25, -0.125), texcoord.xyxy);
+    offset[1] = mad(rtMetrics.xyxy, float4(-0.125, -0.25, -0.125,  1.25), texcoord.xyxy);
+
+    // And these for the searches, they indicate the ends of the loops:
+    offset[2] = mad(rtMetrics.xxyy,
+                    float4(-2.0, 2.0, -2.0, 2.0) * float(maxSearchSteps),
+                    float4(offset[0].xz, offset[1].yw));
+}
+
+void main()
+{
+	outBlock.position = position;
+	outBlock.uv = outBlock.position.xy * 0.5f + 0.5f;
+	//outBlock.uv.y = 1.0 - outBlock.uv.y; // Flip Y coordinate for correct texture sampling
+	SMAABlendingWeightCalculationVS(outBlock.uv, outBlend.pixcoord, outBlend.offset);
+
+	gl_Position = outBlock.position;
+}
\ No newline at end of file
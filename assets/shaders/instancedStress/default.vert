@@ -0,0 +1,31 @@
+#version 440
+
+layout (location = 0) in vec4 position;
+layout (location = 1) in vec2 uv;
+
+out defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} outBlock;
+
+layout(std140, binding = 0) uniform defaultSettings
+{
+	mat4		projection;
+	mat4		view;
+	mat4		translation;
+	vec2		resolution;
+	vec2		mousePosition;
+	float		deltaTime;
+	float		totalTime;
+	float 		framesPerSecond;
+	uint		totalFrames;
+};
+
+void main()
+{
+	outBlock.position = position;
+	outBlock.uv = outBlock.position.xy * 0.5f + 0.5f;
+	gl_Position = outBlock.position;
+}
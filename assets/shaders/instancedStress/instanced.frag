@@ -0,0 +1,91 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 		position;
+	vec4 		normal;
+	vec2		uv;
+} inBlock;
+
+flat in uint drawIndex;
+flat in vec4 instanceTint;
+
+in motionBlock
+{
+	vec4		currentPosition;
+	vec4		previousPosition;
+} inMotion;
+
+layout(location = 0) out vec4 outColor;
+//screen space motion since last frame in UV units. only lands anywhere when the velocity attachment is bound
+layout(location = 1) out vec2 outVelocity;
+
+layout(std140, binding = 0) uniform defaultSettings
+{
+	mat4		projection;
+	mat4 		view;
+	mat4 		translation;
+	vec2		resolution;
+	vec2		mousePosition;
+	float		deltaTime;
+	float		totalTime;
+	float 		framesPerSecond;
+	uint		totalFrames;
+	mat4		previousProjection;
+	mat4		previousView;
+	mat4		previousTranslation;
+	vec2		projectionJitter;
+};
+
+struct material_t
+{
+	vec4		diffuse;
+	vec4		specular;
+	vec4		ambient;
+	vec4		emissive;
+	uvec4		flags; //x = has diffuse map
+	uvec4		textureHandles; //xy = bindless diffuse handle, only set on the bindless path
+};
+
+layout(std430, binding = 0) readonly buffer materialSettings
+{
+	material_t	materials[];
+};
+
+layout(binding = 0) uniform sampler2D diffuse;
+
+// (xchen) gamma to linear sRGB transformation
+const float SRGB_GAMMA = 1.0 / 2.2;
+const float SRGB_INVERSE_GAMMA = 2.2;
+const float SRGB_ALPHA = 0.055;
+
+// (xchen) gamma to linear sRGB transformation
+// Converts a srgb color to a rgb color (approximated, but fast)
+vec3 srgb_to_rgb_approx(vec3 srgb) {
+    return pow(srgb, vec3(SRGB_INVERSE_GAMMA));
+}
+
+vec3 linearToSRGB(vec3 linear) {
+    return pow(clamp(linear, 0.0, 1.0), vec3(0.454545)); // 1.0 / 2.2 ≈ 0.454545
+}
+
+vec3 srgbToLinear(vec3 srgb) {
+    return pow(srgb, vec3(2.2));
+}
+
+void main()
+{
+	//clamp the alpha down hard. if alpha is less than 0.1, clamp it to 0
+	material_t material = materials[drawIndex];
+	vec4 col = (material.flags.x != 0) ? texture(diffuse, inBlock.uv) : material.diffuse;
+
+	// (xchen) gamma to linear sRGB transformation
+	col *= instanceTint;
+	outColor.xyz = col.xyz;// srgbToLinear(col.xyz);
+	outColor.a = col.a;
+
+	//the jitter isn't motion, take it back out of the current position
+	vec2 currentNDC = inMotion.currentPosition.xy / inMotion.currentPosition.w - projectionJitter;
+	vec2 previousNDC = inMotion.previousPosition.xy / inMotion.previousPosition.w;
+	outVelocity = (currentNDC - previousNDC) * 0.5;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#version 450
+#extension GL_ARB_shader_draw_parameters : require
+
+layout (location = 0) in vec4 position;
+layout (location = 1) in vec4 normal;
+layout (location = 2) in vec4 tangent;
+layout (location = 3) in vec4 biTangent;
+layout (location = 4) in vec2 uv;
+
+out defaultBlock
+{
+	vec4 		position;
+	vec4 		normal;
+	vec2		uv;
+} outBlock;
+
+//where this vertex is now and where it was last frame, the fragment shader turns the difference into a velocity
+out motionBlock
+{
+	vec4		currentPosition;
+	vec4		previousPosition;
+} outMotion;
+
+//which of the arena's draws this is, used to look up the material. every path carries it in baseInstance
+flat out uint drawIndex;
+//per instance colour, multiplied into the material
+flat out vec4 instanceTint;
+
+//set when the instances went through cullInstances. gl_InstanceID then indexes the survivors instead
+uniform uint useVisibleList;
+
+layout(std140, binding = 0) uniform defaultSettings
+{
+	mat4		projection;
+	mat4		view;
+	mat4		translation;
+	vec2		resolution;
+	vec2		mousePosition;
+	float		deltaTime;
+	float		totalTime;
+	float 		framesPerSecond;
+	uint 		totalFrames;
+	mat4		previousProjection;
+	mat4		previousView;
+	mat4		previousTranslation;
+	vec2		projectionJitter;
+};
+
+//matches instanceData_t. one entry per copy of the model
+struct instance_t
+{
+	mat4		transform;
+	vec4		tint;
+};
+
+layout(std430, binding = 3) readonly buffer instanceSettings
+{
+	instance_t	instances[];
+};
+
+layout(std430, binding = 4) readonly buffer visibleInstances
+{
+	uint		visibleIndices[];
+};
+
+void main()
+{
+	//instances don't move, so the same transform goes into last frame's position
+	uint instanceIndex = (useVisibleList != 0) ? visibleIndices[gl_InstanceID] : uint(gl_InstanceID);
+	instance_t instance = instances[instanceIndex];
+	vec4 worldPosition = instance.transform * position;
+
+	//move from world space to screen space
+	outBlock.position = projection * view * translation * worldPosition;
+	outBlock.uv = uv;
+	outBlock.normal = instance.transform * vec4(normal.xyz, 0.0);
+	drawIndex = uint(gl_BaseInstanceARB);
+	instanceTint = instance.tint;
+
+	outMotion.currentPosition = outBlock.position;
+	outMotion.previousPosition = previousProjection * previousView * previousTranslation * worldPosition;
+	
+	gl_Position = outBlock.position;
+}
@@ -0,0 +1,91 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+layout(std140, binding = 0) uniform defaultSettings
+{
+	mat4		projection;
+	mat4		view;
+	mat4		translation;
+	vec2		resolution;
+	vec2		mousePosition;
+	float		deltaTime;
+	float		totalTime;
+	float 		framesPerSecond;
+	uint		totalFrames;
+};
+
+layout(std140, binding = 4) uniform upcsaleSettings
+{
+	vec4 metrics; //Z and W are output resolution, xy = rcp(zw). calculate rcp on c++ side
+	vec2 resolutionScale;
+	float blendingFactor;
+	float reproSharpness;
+	float spatialFlickerTime;
+	float timeMax;
+	float timeMin;
+	float edgeThreshold;
+	vec4 jitter; //xy = this frame's offset in scaled pixels
+	mat4 reprojection; //current clip space to last frame's, without jitter
+	uint isHistoryValid;
+	uint hasVelocity;
+	uint interlaceParity; //which lines along interlaceAxis this frame shaded
+	uint interlaceAxis; //0 = columns, 1 = rows
+};
+
+out vec4 outColor;
+
+layout(binding = 0) uniform sampler2D currentTexture; //this frame, scaled resolution
+layout(binding = 1) uniform sampler2D historyTexture; //last frame's output, full resolution
+layout(binding = 2) uniform sampler2D depthTexture; //this frame, scaled resolution
+layout(binding = 3) uniform sampler2D velocityTexture; //this frame, scaled resolution, UV units
+
+void main()
+{
+	vec2 scaledTexel = 1.0 / vec2(textureSize(currentTexture, 0));
+
+	//the jitter moved the whole image, so whatever landed on this pixel was rendered that far over
+	vec2 currentUV = inBlock.uv + jitter.xy * scaledTexel;
+	vec4 current = texture(currentTexture, currentUV);
+
+	//history can only be as far out as what this frame saw around it, anything past that is a ghost
+	vec4 minColor = current;
+	vec4 maxColor = current;
+	for(int y = -1; y <= 1; y++)
+	{
+		for(int x = -1; x <= 1; x++)
+		{
+			vec4 neighbour = texture(currentTexture, currentUV + vec2(x, y) * scaledTexel);
+			minColor = min(minColor, neighbour);
+			maxColor = max(maxColor, neighbour);
+		}
+	}
+
+	//depth only knows about the camera moving, the velocity attachment catches moving objects too
+	vec2 historyUV;
+	if(hasVelocity != 0)
+	{
+		historyUV = inBlock.uv - texture(velocityTexture, currentUV).xy;
+	}
+	else
+	{
+		float depth = texture(depthTexture, currentUV).r;
+		vec4 previous = reprojection * vec4(inBlock.uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+		historyUV = (previous.xy / previous.w) * 0.5 + 0.5;
+	}
+
+	bool isValid = isHistoryValid != 0 && all(greaterThanEqual(historyUV, vec2(0.0))) && all(lessThanEqual(historyUV, vec2(1.0)));
+	vec4 history = clamp(texture(historyTexture, historyUV), minColor, maxColor);
+
+	//the current frame is only exact right on a pixel it rendered. in between it's interpolated, so trust it less there
+	vec2 offsetFromCentre = fract(currentUV / scaledTexel) - 0.5;
+	float confidence = exp(-reproSharpness * dot(offsetFromCentre, offsetFromCentre));
+	float currentWeight = isValid ? clamp(blendingFactor * confidence, timeMin, timeMax) : 1.0;
+
+	outColor = mix(history, current, currentWeight);
+}
@@ -0,0 +1,35 @@
+#version 450
+
+in defaultBlock
+{
+	vec4 position;
+	vec2 uv;
+	vec2 fullUV;
+} inBlock;
+
+//xy = screen x and width, zw = atlas x and width. rows line up with the screen
+layout(std430, binding = 1) readonly buffer tileTable
+{
+	uvec4 grid; //xy = tiles across and down, zw = tile size in screen pixels
+	vec4 tiles[];
+};
+
+layout(location = 0) out vec4 outColor;
+
+layout(binding = 0) uniform sampler2D atlasTexture; //SMAA output, each row's tiles squashed to the left
+
+void main()
+{
+	vec2 pixel = gl_FragCoord.xy;
+	uvec2 tile = min(uvec2(pixel) / grid.zw, grid.xy - 1);
+	vec4 rect = tiles[tile.y * grid.x + tile.x];
+
+	//same mapping the geometry pass viewport used, undone
+	float atlasX = rect.z + (pixel.x - rect.x) * (rect.w / max(rect.y, 1.0));
+
+	//stay half a texel inside the tile so the filter never picks up the neighbour, which sits somewhere else on screen
+	atlasX = clamp(atlasX, rect.z + 0.5, rect.z + rect.w - 0.5);
+
+	vec2 atlasSize = vec2(textureSize(atlasTexture, 0));
+	outColor = texture(atlasTexture, vec2(atlasX, pixel.y) / atlasSize);
+}
@@ -14,7 +14,30 @@ struct resolutionSettings_t
     }
 };
 
-class OAUpsamplerScene final : public SMAAScene
+//matches upcsaleSettings in the shaders, binding 4
+struct upscaleSettings_t
+{
+    glm::vec4 metrics{0}; //zw = output resolution, xy = 1 / zw
+    glm::vec2 resolutionScale{defaultResScale};
+    float blendingFactor = 0.1f; //how much of the current frame goes into the history
+    float reproSharpness = 2.0f; //how fast trust in the current frame drops off away from a rendered pixel centre
+    float spatialFlickerTime = 0.0f;
+    float timeMax = 1.0f;
+    float timeMin = 0.05f; //the current frame never gets less than this
+    float edgeThreshold = 0.1f;
+    glm::vec4 jitter{0}; //xy = this frame's offset in scaled pixels
+    glm::mat4 reprojection{1}; //current clip space to last frame's, without jitter
+    glm::uint isHistoryValid = 0;
+    glm::uint hasVelocity = 0; //reproject with the velocity attachment instead of from depth
+    glm::uint interlaceParity = 0; //which lines along interlaceAxis this frame shaded
+    glm::uint interlaceAxis = 0; //0 = columns, 1 = rows
+    float sharpness = 0.5f; //0 = none, 1 = as much as CAS will give
+    glm::uint upscaleAxis = 0; //the axis the spatial kernel runs along
+    glm::uint numTaps = 4;
+    float filterScale = 1.0f; //source texels per output pixel along upscaleAxis, never below 1
+};
+
+class OAUpsamplerScene : public SMAAScene
 {
 public:
 
@@ -31,9 +54,109 @@ public:
 
     void Initialize() override
     {
+        lookupSettings = GetLookupSettings();
         SMAAScene::Initialize();
 
+        //history is kept at the output resolution, the scaled passes feed into it
+        FBODescriptor historyDesc;
+        historyDesc.dimensions = glm::ivec3(window->GetSettings().resolution.width, window->GetSettings().resolution.height, 1);
+        historyDesc.dataType = GL_FLOAT;
+        historyDesc.format = GL_RGBA;
+        historyDesc.internalFormat = GL_RGBA32F;
+        historyDesc.wrapRSetting = GL_CLAMP_TO_EDGE;
+        historyDesc.wrapTSetting = GL_CLAMP_TO_EDGE;
+        historyDesc.wrapSSetting = GL_CLAMP_TO_EDGE;
+
+        //interlaced reconstruction checks history against the current depth, so it gets kept alongside
+        FBODescriptor historyDepthDesc = historyDesc;
+        historyDepthDesc.format = GL_RED;
+        historyDepthDesc.internalFormat = GL_R32F;
+
+        for (auto& history : historyBuffers)
+        {
+            history.Initialize();
+            history.Bind();
+            history.AddAttachment(frameBuffer::attachment_t("history", historyDesc));
+            history.AddAttachment(frameBuffer::attachment_t("historyDepth", historyDepthDesc));
+        }
+
+        //adaptive tiles squash the scene into the left of each row, this is where it gets spread back out
+        FBODescriptor assembledDesc = historyDesc;
+        assembledDesc.dataType = GL_UNSIGNED_BYTE;
+        assembledDesc.internalFormat = GL_RGBA8;
+        assembledBuffer.Initialize();
+        assembledBuffer.Bind();
+        assembledBuffer.AddAttachment(frameBuffer::attachment_t("assembled", assembledDesc));
+        frameBuffer::Unbind();
 
+        //spatial upscale goes into the first, sharpening into the second
+        spatialBuffer.Initialize();
+        spatialBuffer.Bind();
+        spatialBuffer.AddAttachment(frameBuffer::attachment_t("upscaled", assembledDesc));
+        spatialBuffer.AddAttachment(frameBuffer::attachment_t("sharpened", assembledDesc));
+        frameBuffer::Unbind();
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &weightTexture);
+        glTextureParameteri(weightTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(weightTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTextureStorage2D(weightTexture, 1, GL_R32F, maxTaps, numPhases);
+
+        tileScaler.Initialize(glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height));
+
+        temporalProgram = &shaderProgramsMap["temporal"];
+        interlaceProgram = &shaderProgramsMap["interlace"];
+        tileEdgesProgram = &shaderProgramsMap["tileEdges"];
+        tileAssembleProgram = &shaderProgramsMap["tileAssemble"];
+        spatialUpscaleProgram = &shaderProgramsMap["spatialUpscale"];
+        sharpenProgram = &shaderProgramsMap["sharpen"];
+
+        if (useAdaptiveTiles)
+        {
+            useInterlaced = false;
+            SetAdaptiveTiles(true);
+        }
+
+        else if (useInterlaced)
+        {
+            UpdateResolutionScale(GetInterlacedScale());
+            resolutionSettings.data.resolutionScale = resScale;
+            ResizeBuffers(scaledResolution);
+        }
+    }
+
+    void ShutDown(tWindow* window) override
+    {
+        tileScaler.ShutDown();
+        SMAAScene::ShutDown(window);
+    }
+
+    //--temporal starts with history accumulation on, for benchmarking it
+    void ParseArguments(const int& argc, char* argv[]) override
+    {
+        SMAAScene::ParseArguments(argc, argv);
+        for (int iter = 1; iter < argc; iter++)
+        {
+            if (std::string_view(argv[iter]) == "--temporal")
+            {
+                useTemporal = true;
+                useVelocity = true;
+            }
+
+            else if (std::string_view(argv[iter]) == "--interlaced")
+            {
+                useInterlaced = true;
+            }
+
+            else if (std::string_view(argv[iter]) == "--adaptive")
+            {
+                useAdaptiveTiles = true;
+            }
+
+            else if (std::string_view(argv[iter]) == "--spatial")
+            {
+                useSpatialUpscale = true;
+            }
+        }
     }
 
 protected:
@@ -42,32 +165,300 @@ protected:
     glm::ivec2 scaledResolution{ resScale.x, resScale.y };
     bufferHandler_t<resolutionSettings_t> resolutionSettings;
 
-    void GeometryPass() override
+    //temporal mode. the geometry pass is jittered along the reduced axes and each frame gets blended into a full
+    //resolution history, so the columns a single frame skips get filled in over the next few
+    bool useTemporal = false;
+    bufferHandler_t<upscaleSettings_t> upscaleSettings;
+    std::array<frameBuffer, 2> historyBuffers;
+    uint32_t historyIndex = 0;
+    uint32_t jitterIndex = 0;
+    glm::vec2 jitterPixels{0};
+    glm::mat4 previousViewProjection{1};
+    ShaderProgram_t* temporalProgram = nullptr;
+
+    //interlaced mode. each frame shades every other column (or row) at full resolution through a half size
+    //viewport, nudged half a full resolution pixel either way. the other half comes from history where it
+    //still matches what's around it, and from the current SMAA output where it doesn't
+    bool useInterlaced = false;
+    int interlaceAxis = 0;
+    uint32_t interlaceParity = 0;
+    glm::vec2 scaleBeforeInterlace{defaultResScale};
+    ShaderProgram_t* interlaceProgram = nullptr;
+
+    //adaptive tiles. the screen is cut into a grid and each tile is drawn narrower the fewer edges SMAA found in
+    //it last time, so flat areas cost less. the render targets stay at full size, the tiles are packed into
+    //the left of each row and spread back out over the screen at the end
+    bool useAdaptiveTiles = false;
+    tileScaler_t tileScaler;
+    frameBuffer assembledBuffer;
+    glm::vec2 scaleBeforeTiles{defaultResScale};
+    ShaderProgram_t* tileEdgesProgram = nullptr;
+    ShaderProgram_t* tileAssembleProgram = nullptr;
+
+    glm::vec2 GetInterlacedScale() const
     {
-        geometryBuffer.Bind();
+        return (interlaceAxis == 0) ? glm::vec2(0.5f, 1.0f) : glm::vec2(1.0f, 0.5f);
+    }
 
-        glDrawBuffers(1, &geometryBuffer.attachments["color"].FBODesc.attachmentFormat);
+    //offset that lines the half size pixel centres up with this frame's full resolution lines, in NDC
+    glm::vec2 GetInterlaceOffset() const
+    {
+        const glm::vec2 windowResolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        glm::vec2 offset = glm::vec2(0);
+        offset[interlaceAxis] = (1.0f - 2.0f * (float)interlaceParity) / windowResolution[interlaceAxis];
+        return offset;
+    }
 
-        //we just need the first LOd so only do the first 3 meshes
-        for (auto& mesh : testModel.meshes)
+    void SetInterlaced(const bool& isInterlaced)
+    {
+        if (isInterlaced)
         {
-            for (uint32_t texIter = 0; texIter < mesh.textures.size(); texIter++)
+            scaleBeforeInterlace = useInterlaced ? scaleBeforeInterlace : resScale;
+            if (useAdaptiveTiles)
             {
-                mesh.textures[texIter].SetActive(texIter);
+                SetAdaptiveTiles(false);
             }
+            UpdateResolutionScale(GetInterlacedScale());
+            useTemporal = false;
+        }
 
-            glBindVertexArray(mesh.vertexArrayHandle);
-            glUseProgram(geometryProgram->handle);
+        else
+        {
+            UpdateResolutionScale(scaleBeforeInterlace);
+        }
 
-            glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+        useInterlaced = isInterlaced;
+        resolutionSettings.data.resolutionScale = resScale;
+        ResizeBuffers(scaledResolution);
+    }
 
-            if (wireframe)
+    //the tiles do their own scaling, so everything else runs at the window resolution
+    void SetAdaptiveTiles(const bool& isAdaptive)
+    {
+        if (isAdaptive)
+        {
+            if (useInterlaced)
             {
-                glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+                SetInterlaced(false);
             }
-            glDrawElements(GL_TRIANGLES, mesh.indices.size(), GL_UNSIGNED_INT, nullptr);
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            scaleBeforeTiles = useAdaptiveTiles ? scaleBeforeTiles : resScale;
+            UpdateResolutionScale(glm::vec2(1.0f));
+            useTemporal = false;
+        }
+
+        else
+        {
+            UpdateResolutionScale(scaleBeforeTiles);
         }
+
+        useAdaptiveTiles = isAdaptive;
+        resolutionSettings.data.resolutionScale = resScale;
+        ResizeBuffers(scaledResolution);
+    }
+
+    //spatial upscale. the scale usually only drops along one axis, so a 1D lanczos along that axis
+    //(steered along edges) gets back much more than the bilinear stretch, then CAS sharpens the result
+    bool useSpatialUpscale = false;
+    frameBuffer spatialBuffer;
+    GLuint weightTexture = 0;
+    float weightScale = 0.0f; //filterScale the weights were last built for
+    ShaderProgram_t* spatialUpscaleProgram = nullptr;
+    ShaderProgram_t* sharpenProgram = nullptr;
+
+    static constexpr GLuint maxTaps = 8;
+    static constexpr GLuint numPhases = 64;
+
+    static float Lanczos2(const float& x)
+    {
+        if (std::abs(x) < 1e-5f)
+        {
+            return 1.0f;
+        }
+
+        if (std::abs(x) >= 2.0f)
+        {
+            return 0.0f;
+        }
+
+        const float piX = glm::pi<float>() * x;
+        return 2.0f * std::sin(piX) * std::sin(piX * 0.5f) / (piX * piX);
+    }
+
+    //one row per sub-texel phase, one column per tap. when the source is bigger than the output the kernel
+    //gets stretched to cover it, so the number of taps depends on the scale
+    void UpdateWeights()
+    {
+        const GLuint axis = (resScale.x <= resScale.y) ? 0 : 1;
+        const float filterScale = std::max(resScale[axis], 1.0f);
+        const GLuint numTaps = std::min<GLuint>(2 * (GLuint)std::ceil(2.0f * filterScale), maxTaps);
+
+        upscaleSettings.data.upscaleAxis = axis;
+        upscaleSettings.data.filterScale = filterScale;
+        upscaleSettings.data.numTaps = numTaps;
+
+        if (filterScale == weightScale)
+        {
+            return;
+        }
+        weightScale = filterScale;
+
+        std::vector<float> weights(maxTaps * numPhases, 0.0f);
+        const int firstTap = 1 - (int)numTaps / 2;
+        for (GLuint phaseIter = 0; phaseIter < numPhases; phaseIter++)
+        {
+            const float phase = (float)phaseIter / (float)numPhases;
+            float sum = 0.0f;
+            for (GLuint tapIter = 0; tapIter < numTaps; tapIter++)
+            {
+                const float distance = (float)(firstTap + (int)tapIter) - phase;
+                weights[phaseIter * maxTaps + tapIter] = Lanczos2(distance / filterScale);
+                sum += weights[phaseIter * maxTaps + tapIter];
+            }
+
+            for (GLuint tapIter = 0; tapIter < numTaps; tapIter++)
+            {
+                weights[phaseIter * maxTaps + tapIter] /= sum;
+            }
+        }
+
+        glTextureSubImage2D(weightTexture, 0, 0, 0, maxTaps, numPhases, GL_RED, GL_FLOAT, weights.data());
+    }
+
+    void SpatialUpscalePass()
+    {
+        UpdateWeights();
+        upscaleSettings.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+
+        spatialBuffer.Bind();
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+
+        glState_t::Get().DrawBuffers(1, &spatialBuffer.attachments["upscaled"].FBODesc.attachmentFormat);
+        SMAABuffer.attachments["SMAA"].SetActive(0);
+        glState_t::Get().BindTextureUnit(1, weightTexture);
+        glState_t::Get().UseProgram(spatialUpscaleProgram->handle);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        glState_t::Get().DrawBuffers(1, &spatialBuffer.attachments["sharpened"].FBODesc.attachmentFormat);
+        spatialBuffer.attachments["upscaled"].SetActive(0);
+        glState_t::Get().UseProgram(sharpenProgram->handle);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        frameBuffer::Unbind();
+    }
+
+    static float Halton(uint32_t index, const uint32_t& base)
+    {
+        float fraction = 1.0f;
+        float result = 0.0f;
+        while (index > 0)
+        {
+            fraction /= (float)base;
+            result += fraction * (float)(index % base);
+            index /= base;
+        }
+        return result;
+    }
+
+    //next offset in the sequence, in NDC for the projection. axes that aren't scaled down stay put
+    glm::vec2 NextJitter()
+    {
+        //the lower the scale the more frames it takes to visit every missing column
+        const float lowestScale = std::max(std::min(resScale.x, resScale.y), 0.1f);
+        const uint32_t numPhases = std::min<uint32_t>(8 * (uint32_t)std::ceil(1.0f / lowestScale), 64);
+        jitterIndex = (jitterIndex % numPhases) + 1;
+
+        jitterPixels = glm::vec2(Halton(jitterIndex, 2), Halton(jitterIndex, 3)) - 0.5f;
+        jitterPixels.x = (resScale.x < 1.0f) ? jitterPixels.x : 0.0f;
+        jitterPixels.y = (resScale.y < 1.0f) ? jitterPixels.y : 0.0f;
+        return jitterPixels * 2.0f / glm::vec2(scaledResolution);
+    }
+
+    void InvalidateHistory()
+    {
+        upscaleSettings.data.isHistoryValid = 0;
+        jitterIndex = 0;
+    }
+
+    void GeometryPass() override
+    {
+        BindGeometryTarget();
+
+        SetGeometryDrawBuffers();
+
+        //LODs are picked against the resolution we actually render at, not the window
+        testModel.SelectLODs(renderCamera.view, renderCamera.projection, glm::vec2(scaledResolution));
+        geometryArena.ApplyLODs(testModel);
+
+        glState_t::Get().UseProgram(geometryProgram->handle);
+        glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+
+        if (wireframe)
+        {
+            glState_t::Get().PolygonMode(GL_LINE);
+        }
+
+        if (useAdaptiveTiles)
+        {
+            DrawTiles();
+        }
+
+        else
+        {
+            DrawGeometry();
+        }
+        glState_t::Get().PolygonMode(GL_FILL);
+        frameBuffer::Unbind();
+    }
+
+    //one scissored draw per tile. the viewport squeezes the whole screen horizontally by the tile's scale and
+    //slides it so the tile's part lands on its slot in the row, the scissor keeps the rest out
+    void DrawTiles()
+    {
+        const glm::vec2 windowResolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        glState_t::Get().SetEnabled(GL_SCISSOR_TEST, true);
+
+        const auto& tiles = tileScaler.GetTiles();
+        for (GLuint tileIter = 0; tileIter < tileScaler.GetNumTiles(); tileIter++)
+        {
+            const glm::vec4& rect = tiles[tileIter].rect;
+            const GLuint row = tileIter / tileScaler_t::gridSize.x;
+            const GLint tileHeight = tileScaler.GetTileHeight(row);
+            if (rect.w <= 0.0f || tileHeight <= 0)
+            {
+                continue;
+            }
+
+            const float scale = rect.w / rect.y;
+            glState_t::Get().ViewportF(rect.z - rect.x * scale, 0.0f, windowResolution.x * scale, windowResolution.y);
+            glState_t::Get().Scissor((GLint)rect.z, tileScaler.GetTileY(row), (GLsizei)rect.w, tileHeight);
+            DrawGeometry();
+        }
+
+        glState_t::Get().SetEnabled(GL_SCISSOR_TEST, false);
+    }
+
+    //the draw calls of the geometry pass, with the target, program and viewport already set up. derived scenes
+    //swap in their own geometry here and keep the rest of the pass chain
+    virtual void DrawGeometry()
+    {
+        geometryArena.Draw(geometryProgram->handle);
+    }
+
+    //spreads each row's tiles back out to full width
+    void AssemblePass()
+    {
+        assembledBuffer.Bind();
+        glState_t::Get().DrawBuffers(1, &assembledBuffer.attachments["assembled"].FBODesc.attachmentFormat);
+
+        SMAABuffer.attachments["SMAA"].SetActive(0);
+        tileScaler.BindTable(tileScaler_t::tableBinding);
+
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(tileAssembleProgram->handle);
+        glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
         frameBuffer::Unbind();
     }
 
@@ -75,32 +466,38 @@ protected:
     {
         edgesBuffer.Bind();
 
-        glDrawBuffers(1, &edgesBuffer.attachments["edge"].FBODesc.attachmentFormat);
+        glState_t::Get().DrawBuffers(1, &edgesBuffer.attachments["edge"].FBODesc.attachmentFormat);
 
         geometryBuffer.attachments["color"].SetActive(0);//color
         geometryBuffer.attachments["depth"].SetActive(1);//depth
 
-        glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-        glUseProgram(edgeDetectionProgram->handle);
-        glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(edgeDetectionProgram->handle);
+        glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         frameBuffer::Unbind();
+
+        //with S2x this runs once per sample, the count only goes out for the first since the second finds it busy
+        if (useAdaptiveTiles)
+        {
+            tileScaler.CountEdges(edgesBuffer.attachments["edge"].GetHandle(), tileEdgesProgram->handle);
+        }
     }
 
     void BlendingWeightsPass() override
     {
         weightsBuffer.Bind();
 
-        glDrawBuffers(1, &weightsBuffer.attachments["blend"].FBODesc.attachmentFormat);
+        glState_t::Get().DrawBuffers(1, &weightsBuffer.attachments["blend"].FBODesc.attachmentFormat);
 
         edgesBuffer.attachments["edge"].SetActive(0);
         SMAAArea.SetActive(1);
         SMAASearch.SetActive(2);
 
-        glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-        glUseProgram(blendingWeightProgram->handle);
-        glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(blendingWeightProgram->handle);
+        glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         frameBuffer::Unbind();
@@ -109,47 +506,168 @@ protected:
     void SMAAPass() override
     {
         SMAABuffer.Bind();
-        glDrawBuffers(1, &SMAABuffer.attachments["SMAA"].FBODesc.attachmentFormat);
+        glState_t::Get().DrawBuffers(1, &SMAABuffer.attachments["SMAA"].FBODesc.attachmentFormat);
 
         //current frame
         geometryBuffer.attachments["color"].SetActive(0); //color
         weightsBuffer.attachments["blend"].SetActive(1); //blending weights
 
-        glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-        glUseProgram(SMAAProgram->handle);
-        glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(SMAAProgram->handle);
+        glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, scaledResolution.x, scaledResolution.y);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        frameBuffer::Unbind();
+    }
+
+    //reprojects last frame's output onto this one, clamps it to what the current frame saw around that pixel
+    //and blends the two. writes into the other history buffer, which becomes the output
+    void TemporalPass(const glm::mat4& viewProjection)
+    {
+        UpdateUpscaleSettings(viewProjection);
+
+        frameBuffer& target = historyBuffers[1 - historyIndex];
+        target.Bind();
+        glState_t::Get().DrawBuffers(1, &target.attachments["history"].FBODesc.attachmentFormat);
+
+        SMAABuffer.attachments["SMAA"].SetActive(0);
+        historyBuffers[historyIndex].attachments["history"].SetActive(1);
+        geometryBuffer.attachments["depth"].SetActive(2);
+        if (useVelocity)
+        {
+            geometryBuffer.attachments["velocity"].SetActive(3);
+        }
+
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(temporalProgram->handle);
+        glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+
+        frameBuffer::Unbind();
+
+        historyIndex = 1 - historyIndex;
+        upscaleSettings.data.isHistoryValid = 1;
+    }
+
+    //puts this frame's lines straight into the full resolution output and fills in the rest
+    void InterlacePass(const glm::mat4& viewProjection)
+    {
+        UpdateUpscaleSettings(viewProjection);
+
+        frameBuffer& target = historyBuffers[1 - historyIndex];
+        target.Bind();
+        const GLenum drawBuffers[2] = { target.attachments["history"].FBODesc.attachmentFormat, target.attachments["historyDepth"].FBODesc.attachmentFormat };
+        glState_t::Get().DrawBuffers(2, drawBuffers);
+
+        SMAABuffer.attachments["SMAA"].SetActive(0);
+        historyBuffers[historyIndex].attachments["history"].SetActive(1);
+        geometryBuffer.attachments["depth"].SetActive(2);
+        if (useVelocity)
+        {
+            geometryBuffer.attachments["velocity"].SetActive(3);
+        }
+        historyBuffers[historyIndex].attachments["historyDepth"].SetActive(4);
+
+        glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+        glState_t::Get().UseProgram(interlaceProgram->handle);
+        glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
         glDrawArrays(GL_TRIANGLES, 0, 6);
 
         frameBuffer::Unbind();
+
+        historyIndex = 1 - historyIndex;
+        upscaleSettings.data.isHistoryValid = 1;
+        interlaceParity = 1 - interlaceParity;
     }
 
-    void Update() override
+    void UpdateUpscaleSettings(const glm::mat4& viewProjection)
     {
-        SMAAScene::Update();
+        const glm::vec2 windowResolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        upscaleSettings.data.metrics = glm::vec4(1.0f / windowResolution, windowResolution);
+        upscaleSettings.data.resolutionScale = resScale;
+        upscaleSettings.data.jitter = glm::vec4(jitterPixels, 0, 0);
+        upscaleSettings.data.reprojection = previousViewProjection * glm::inverse(viewProjection);
+        upscaleSettings.data.hasVelocity = useVelocity ? 1 : 0;
+        upscaleSettings.data.interlaceParity = interlaceParity;
+        upscaleSettings.data.interlaceAxis = (glm::uint)interlaceAxis;
+        upscaleSettings.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+    }
+
+    void UpdateUniforms() override
+    {
+        SMAAScene::UpdateUniforms();
         resolutionSettings.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
     }
 
     void Draw() override
     {
-        camera.ChangeProjection(camera_t::projection_e::perspective);
-        camera.Update();
+        //whatever edge counts have come back since pick this frame's tile scales
+        if (useAdaptiveTiles)
+        {
+            tileScaler.Update();
+        }
+
+        //the snapshot carries the main thread's camera, which doesn't know about the scaled passes
+        renderCamera.resolution = glm::vec2(window->GetSettings().resolution.x, window->GetSettings().resolution.y);
+        renderCamera.ChangeProjection(camera_t::projection_e::perspective);
+        renderCamera.Update();
+        renderCamera.UpdateProjection();
+        const glm::mat4 viewProjection = renderCamera.projection * renderCamera.view;
+
+        if (useInterlaced)
+        {
+            projectionJitter = GetInterlaceOffset();
+        }
+
+        else
+        {
+            projectionJitter = useTemporal ? NextJitter() : glm::vec2(0);
+        }
         UpdateDefaultBuffer();
 
         GeometryPass();
+        projectionJitter = glm::vec2(0);
 
-        camera.resolution = scaledResolution;
-        camera.ChangeProjection(camera_t::projection_e::orthographic);
-        camera.Update();
+        renderCamera.resolution = scaledResolution;
+        renderCamera.ChangeProjection(camera_t::projection_e::orthographic);
+        renderCamera.Update();
         UpdateDefaultBuffer();
 
-        EdgeDetectionPass();
-        BlendingWeightsPass();
-        SMAAPass();
+        SMAAPasses();
 
-        camera.resolution = glm::vec2(window->GetSettings().resolution.x, window->GetSettings().resolution.y);
-        camera.Update();
+        renderCamera.resolution = glm::vec2(window->GetSettings().resolution.x, window->GetSettings().resolution.y);
+        renderCamera.Update();
         UpdateDefaultBuffer();
-        FinalPass(&SMAABuffer.attachments["SMAA"], &geometryBuffer.attachments["color"]);
+
+        if (useInterlaced)
+        {
+            InterlacePass(viewProjection);
+            FinalPass(&historyBuffers[historyIndex].attachments["history"], &geometryBuffer.attachments["color"]);
+        }
+
+        else if (useAdaptiveTiles)
+        {
+            AssemblePass();
+            FinalPass(&assembledBuffer.attachments["assembled"], &geometryBuffer.attachments["color"]);
+        }
+
+        else if (useTemporal)
+        {
+            TemporalPass(viewProjection);
+            FinalPass(&historyBuffers[historyIndex].attachments["history"], &geometryBuffer.attachments["color"]);
+        }
+
+        else if (useSpatialUpscale)
+        {
+            SpatialUpscalePass();
+            FinalPass(&spatialBuffer.attachments["sharpened"], &geometryBuffer.attachments["color"]);
+        }
+
+        else
+        {
+            FinalPass(&SMAABuffer.attachments["SMAA"], &geometryBuffer.attachments["color"]);
+        }
+        previousViewProjection = viewProjection;
 
         DrawGUI(window);
 
@@ -162,53 +680,135 @@ protected:
     {
         SMAAScene::InitializeUniforms();
         resolutionSettings.Initialize(2);
+        upscaleSettings.Initialize(4);
     }
 
     void ResizeBuffers(const glm::ivec2 resolution) override
     {
-        for (auto val : geometryBuffer.attachments | std::views::values)
-        {
-            val.Resize(resolution);
-        }
-
-        for (auto val : edgesBuffer.attachments | std::views::values)
-        {
-            val.Resize(resolution);
-        }
+        geometryBuffer.Resize(glm::ivec3(resolution, 1));
+        edgesBuffer.Resize(glm::ivec3(resolution, 1));
+        weightsBuffer.Resize(glm::ivec3(resolution, 1));
+        SMAABuffer.Resize(glm::ivec3(resolution, 1));
+        ResizeMultisampleBuffer(resolution);
+        UpdateLookupTextures(GetLookupSettings());
+
+        InvalidateHistory();
+    }
 
-        for (auto val : weightsBuffer.attachments | std::views::values)
-        {
-            val.Resize(resolution);
-        }
+    //edges in the scaled buffers get stretched by the ratio between the two axis scales on the way out, so the
+    //area texture is built for that. snapped to quarter steps so dragging the scale doesn't regenerate every frame
+    SMAALookupSettings_t GetLookupSettings() const
+    {
+        const float lowest = std::max(std::min(resScale.x, resScale.y), 0.1f);
+        SMAALookupSettings_t settings = lookupSettings;
+        settings.stretch = std::max(std::round(4.0f * std::max(resScale.x, resScale.y) / lowest) / 4.0f, 1.0f);
+        return settings;
+    }
 
-        for (auto val : SMAABuffer.attachments | std::views::values)
+    void ResizeHistory(const glm::ivec2& resolution)
+    {
+        for (auto& history : historyBuffers)
         {
-            val.Resize(resolution);
+            history.attachments["history"].Resize(resolution);
+            history.attachments["historyDepth"].Resize(resolution);
         }
+        assembledBuffer.attachments["assembled"].Resize(resolution);
+        spatialBuffer.attachments["upscaled"].Resize(resolution);
+        spatialBuffer.attachments["sharpened"].Resize(resolution);
+        tileScaler.Resize(resolution);
+        InvalidateHistory();
     }
 
     void HandleWindowResize(const tWindow* window, const vec2_t<uint16_t>& dimensions) override
     {
-        UpdateResolution(glm::ivec2(dimensions.x, dimensions.y));
-        ResizeBuffers(glm::ivec2(scaledResolution));
+        const glm::ivec2 resolution = glm::ivec2(dimensions.x, dimensions.y);
+        DeferToRenderThread([this, resolution]()
+        {
+            UpdateResolution(resolution);
+            ResizeBuffers(glm::ivec2(scaledResolution));
+            ResizeHistory(resolution);
+        });
     }
 
     void HandleMaximize(const tWindow* window) override
     {
-        UpdateResolution(glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height));
-        ResizeBuffers(glm::ivec2(scaledResolution));
+        const glm::ivec2 resolution = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+        DeferToRenderThread([this, resolution]()
+        {
+            UpdateResolution(resolution);
+            ResizeBuffers(glm::ivec2(scaledResolution));
+            ResizeHistory(resolution);
+        });
     }
 
     void DrawResolutionSettings()
     {
         if (ImGui::BeginTabItem("resolution scale"))
         {
+            //interlaced and adaptive modes own the scale while they're on
+            ImGui::BeginDisabled(useInterlaced || useAdaptiveTiles);
             if (ImGui::DragFloat("scaleX", &resolutionSettings.data.resolutionScale.x, 0.01f, 0.1f, 2.0f) ||
                 ImGui::DragFloat("scaleY", &resolutionSettings.data.resolutionScale.y, 0.01f, 0.1f, 2.0f))
             {
                 UpdateResolutionScale(resolutionSettings.data.resolutionScale);
                 ResizeBuffers(scaledResolution);
             }
+            ImGui::EndDisabled();
+
+            if (ImGui::Checkbox("temporal", &useTemporal))
+            {
+                if (useTemporal && useInterlaced)
+                {
+                    SetInterlaced(false);
+                }
+
+                if (useTemporal && useAdaptiveTiles)
+                {
+                    SetAdaptiveTiles(false);
+                }
+                InvalidateHistory();
+            }
+
+            bool isInterlaced = useInterlaced;
+            if (ImGui::Checkbox("interlaced", &isInterlaced))
+            {
+                SetInterlaced(isInterlaced);
+            }
+
+            if (ImGui::Combo("interlaced axis", &interlaceAxis, "columns\0rows\0") && useInterlaced)
+            {
+                SetInterlaced(true);
+            }
+
+            bool isAdaptive = useAdaptiveTiles;
+            if (ImGui::Checkbox("adaptive tiles", &isAdaptive))
+            {
+                SetAdaptiveTiles(isAdaptive);
+            }
+
+            if (useAdaptiveTiles)
+            {
+                //thresholds have to stay in order or a tile could skip a level
+                ImGui::DragFloat3("edge density thresholds", tileScaler.densityThresholds.data(), 0.001f, 0.0f, 1.0f, "%.3f");
+                tileScaler.densityThresholds[1] = std::max(tileScaler.densityThresholds[1], tileScaler.densityThresholds[0]);
+                tileScaler.densityThresholds[2] = std::max(tileScaler.densityThresholds[2], tileScaler.densityThresholds[1]);
+                ImGui::Text("shaded: %.1f%% of the screen", tileScaler.GetCoverage() * 100.0f);
+            }
+
+            //only used when none of the modes above are, they all output at full resolution already
+            ImGui::Checkbox("spatial upscale", &useSpatialUpscale);
+            if (useSpatialUpscale)
+            {
+                ImGui::SliderFloat("sharpness", &upscaleSettings.data.sharpness, 0.0f, 1.0f);
+                ImGui::SliderFloat("edge threshold", &upscaleSettings.data.edgeThreshold, 0.01f, 1.0f);
+            }
+
+            if (useTemporal)
+            {
+                ImGui::SliderFloat("blending factor", &upscaleSettings.data.blendingFactor, 0.01f, 1.0f);
+                ImGui::SliderFloat("reprojection sharpness", &upscaleSettings.data.reproSharpness, 0.0f, 8.0f);
+                ImGui::SliderFloat("minimum current weight", &upscaleSettings.data.timeMin, 0.0f, 1.0f);
+            }
             ImGui::EndTabItem();
         }
     }
@@ -223,8 +823,8 @@ protected:
     {
         resScale =  resolutionScale;
         scaledResolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height) * resScale;
-        camera.resolution = scaledResolution;
-        camera.Update();
+        renderCamera.resolution = scaledResolution;
+        renderCamera.Update();
 
         SMAASettings.data.rtMetrics = glm::vec4(1.0 / scaledResolution.x, 1.0 / scaledResolution.y, scaledResolution.x, scaledResolution.y);
     }
@@ -232,8 +832,8 @@ protected:
     void UpdateResolution(const glm::ivec2& resolution)
     {
         scaledResolution = glm::vec2(resolution.x, resolution.y) * resScale;
-        camera.resolution = scaledResolution;
-        camera.Update();
+        renderCamera.resolution = scaledResolution;
+        renderCamera.Update();
 
         SMAASettings.data.rtMetrics = glm::vec4(1.0 / scaledResolution.x, 1.0 / scaledResolution.y, scaledResolution.x, scaledResolution.y);
     }
@@ -1,8 +1,9 @@
 #include "OAUpsampler.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 	OAUpsamplerScene exampleScene = OAUpsamplerScene();
+	exampleScene.ParseArguments(argc, argv);
 	exampleScene.Initialize();
 	exampleScene.Run();
 
@@ -2,6 +2,7 @@
 
 #include "scene3D.h"
 #include "FrameBuffer.h"
+#include "SMAALookup.h"
 
 enum class EdgeDetectionMode_e
 {
@@ -21,6 +22,16 @@ struct SMAASettings_t
 	int32_t		cornerRounding;
 	int32_t		edgeDetectionMode;
 
+	//luma and color modes only. depth edges lower the threshold, everywhere else gets predicationScale times it
+	float		predicationThreshold = 0.01f;
+	float		predicationScale = 2.0f;
+	float		predicationStrength = 0.4f;
+	int32_t		usePredication = 0;
+
+	//S2x. which multisample sample is being worked on, and the SMAA subsample index that goes with it (0 = SMAA 1x)
+	int32_t		sampleIndex = 0;
+	int32_t		subsampleIndex = 0;
+
 	explicit SMAASettings_t(const glm::ivec2& resolution = defaultWindowSize, const float threshold = 0.05, const float CAFactor = 2.0f,
 		const uint8_t maxSearchSteps = 32, const uint8_t maxSearchStepsDiag = 16, const uint8_t cornerRounding = 25,
 		const EdgeDetectionMode_e& edgeDetectionMode = EdgeDetectionMode_e::color)
@@ -46,8 +57,8 @@ public:
 		const model_t& model = model_t("models/SoulSpear/SoulSpear.fbx"))
 		: scene3D(windowName, camera, shaderConfigPath, model)
 	{
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(GL_LESS);
+		glState_t::Get().SetEnabled(GL_DEPTH_TEST, true);
+		glState_t::Get().DepthFunc(GL_LESS);
 
 		//soulspear is loaded at an awkward angle so let's hack this
 		this->camera.Roll(glm::radians(180.0f));
@@ -59,9 +70,6 @@ public:
 		edgesBuffer = frameBuffer();
 		weightsBuffer = frameBuffer();
 		SMAABuffer = frameBuffer();
-
-		SMAAArea = texture("textures/SMAA/AreaTexDX_Flipped.png");
-		SMAASearch = texture("assets/textures/SMAA/SearchTex_Flipped.dds");
 	}
 
 	~SMAAScene() override = default;
@@ -70,11 +78,7 @@ public:
 	{
 		scene3D::Initialize();
 
-		SMAAArea.LoadTexture();
-		SMAASearch.LoadTexture();
-
-		SMAASearch.SetMagFilter(GL_NEAREST);
-		SMAASearch.SetMinFilter(GL_NEAREST);
+		UpdateLookupTextures(lookupSettings);
 
 		FBODescriptor colorDesc;
 		colorDesc.dimensions = glm::ivec3(window->GetSettings().resolution.width, window->GetSettings().resolution.height, 1);
@@ -101,6 +105,14 @@ public:
 		geometryBuffer.AddAttachment(frameBuffer::attachment_t("color", colorDesc));
 		geometryBuffer.AddAttachment(frameBuffer::attachment_t("depth", depthDesc));
 
+		if (useVelocity)
+		{
+			FBODescriptor velocityDesc = colorDesc;
+			velocityDesc.format = GL_RG;
+			velocityDesc.internalFormat = GL_RG16F;
+			geometryBuffer.AddAttachment(frameBuffer::attachment_t("velocity", velocityDesc));
+		}
+
 		edgesBuffer.Initialize();
 		edgesBuffer.Bind();
 
@@ -132,16 +144,51 @@ public:
 		SMAABuffer.Bind();
 		SMAABuffer.AddAttachment(frameBuffer::attachment_t("SMAA", colorDesc));
 
-		geometryProgram = &shaderProgramsMap["geometry"];
+		geometryProgram = geometryArena.IsBindless() ? &shaderProgramsMap["geometryBindless"] : &shaderProgramsMap["geometry"];
 		edgeDetectionProgram = &shaderProgramsMap["edgeDetection"];
 		blendingWeightProgram = &shaderProgramsMap["blendingWeight"];
 		SMAAProgram = &shaderProgramsMap["SMAA"];
 		compareProgram = &shaderProgramsMap["compare"];
 		finalProgram = &shaderProgramsMap["final"];
+		separateProgram = &shaderProgramsMap["separateSamples"];
 
 		frameBuffer::Unbind();
 
-		glDisable(GL_MULTISAMPLE);
+		if (useS2x)
+		{
+			InitializeMultisampleBuffer();
+		}
+
+		//only the multisampled geometry target cares, everything else is single sampled
+		glState_t::Get().SetEnabled(GL_MULTISAMPLE, useS2x);
+	}
+
+	//--bindless pulls the diffuse maps out of the material table instead of binding them per batch
+	void ParseArguments(const int& argc, char* argv[]) override
+	{
+		scene3D::ParseArguments(argc, argv);
+		for (int iter = 1; iter < argc; iter++)
+		{
+			if (std::string_view(argv[iter]) == "--bindless")
+			{
+				geometryArena.useBindless = true;
+			}
+
+			else if (std::string_view(argv[iter]) == "--velocity")
+			{
+				useVelocity = true;
+			}
+
+			else if (std::string_view(argv[iter]) == "--predication")
+			{
+				SMAASettings.data.usePredication = 1;
+			}
+
+			else if (std::string_view(argv[iter]) == "--s2x")
+			{
+				useS2x = true;
+			}
+		}
 	}
 
 protected:
@@ -153,6 +200,8 @@ protected:
 
 	texture						SMAAArea;
 	texture						SMAASearch;
+	SMAALookupSettings_t		lookupSettings;
+	bool						hasLookupTextures = false;
 
 	bufferHandler_t<SMAASettings_t>		SMAASettings;
 
@@ -162,49 +211,261 @@ protected:
 	ShaderProgram_t* SMAAProgram = nullptr;
 	ShaderProgram_t* compareProgram = nullptr;
 	ShaderProgram_t* finalProgram = nullptr;
+	ShaderProgram_t* separateProgram = nullptr;
+
+	//S2x: the geometry pass goes into a 2x multisampled copy of the geometry buffer, then each sample gets
+	//copied out and run through edge detection, blending weights and neighborhood blending on its own,
+	//with the second one blended 50/50 over the first
+	bool useS2x = false;
+	frameBuffer multisampleBuffer;
+	std::array<int32_t, 2> subsampleIndices = { 1, 2 };
+	static constexpr GLuint numS2xSamples = 2;
+
+	//sub-pixel offset for the geometry pass in NDC. zero unless a derived scene accumulates over frames
+	glm::vec2 projectionJitter = glm::vec2(0);
+
+	//adds an RG16F "velocity" attachment to the geometry buffer. has to be decided before Initialize
+	bool useVelocity = false;
+	glm::mat4 previousProjection = glm::mat4(1);
+	glm::mat4 previousView = glm::mat4(1);
+	glm::mat4 previousTranslation = glm::mat4(1);
+	bool hasPreviousMatrices = false;
+
+	//area and search textures are generated (or read back from the cache) rather than loaded from the reference images.
+	//no-op when they're already built for these settings
+	void UpdateLookupTextures(const SMAALookupSettings_t& settings)
+	{
+		if (hasLookupTextures && settings == lookupSettings)
+		{
+			return;
+		}
+		lookupSettings = settings;
+		hasLookupTextures = true;
+
+		decodedImage_t area;
+		area.cooked = SMAALookup_t::LoadArea(settings);
+		SMAAArea.UploadImage(area);
+		SMAAArea.SetPath(SMAALookup_t::GetCachePath("AreaTex", settings).c_str());
+
+		//the search texture has to be point sampled. set through the descriptor, SetMinFilter/SetMagFilter take an index
+		decodedImage_t search;
+		search.cooked = SMAALookup_t::LoadSearch(settings);
+		SMAASearch.texDesc.minFilterSetting = GL_NEAREST;
+		SMAASearch.texDesc.magFilterSetting = GL_NEAREST;
+		SMAASearch.UploadImage(search);
+		SMAASearch.SetPath(SMAALookup_t::GetCachePath("SearchTex", settings).c_str());
+	}
 
-	int currentTexture = 0;
-	bool enableCompare = true;
+	//made on first use so S2x can be switched on from the GUI as well as at launch
+	void InitializeMultisampleBuffer()
+	{
+		if (!multisampleBuffer.attachments.empty())
+		{
+			return;
+		}
+
+		multisampleBuffer.Initialize();
+		multisampleBuffer.Bind();
+
+		//same attachments in the same order as the geometry buffer, so the geometry shaders' outputs line up
+		for (const char* name : { "color", "depth", "velocity" })
+		{
+			if (!geometryBuffer.attachments.contains(name))
+			{
+				continue;
+			}
+
+			FBODescriptor multisampleDesc = geometryBuffer.attachments[name].FBODesc;
+			multisampleDesc.target = GL_TEXTURE_2D_MULTISAMPLE;
+			multisampleDesc.sampleCount = numS2xSamples;
+			multisampleBuffer.AddAttachment(frameBuffer::attachment_t(name, multisampleDesc));
+		}
+		frameBuffer::Unbind();
+
+		//SMAA's S2x indices assume sample 0 sits right of centre, like the D3D 2x pattern. GL leaves the pattern
+		//to the driver, so ask for it and hand index 1 to whichever sample is on the right
+		multisampleBuffer.Bind();
+		glm::vec2 samplePositions[numS2xSamples] = {};
+		for (GLuint sampleIter = 0; sampleIter < numS2xSamples; sampleIter++)
+		{
+			glGetMultisamplefv(GL_SAMPLE_POSITION, sampleIter, glm::value_ptr(samplePositions[sampleIter]));
+		}
+		frameBuffer::Unbind();
+
+		const bool isFirstOnRight = samplePositions[0].x >= samplePositions[1].x;
+		subsampleIndices = isFirstOnRight ? std::array<int32_t, 2>{ 1, 2 } : std::array<int32_t, 2>{ 2, 1 };
+	}
+
+	//multisample storage is immutable, so resizing makes a new texture that has to be attached again
+	void ResizeMultisampleBuffer(const glm::ivec2& resolution)
+	{
+		if (multisampleBuffer.attachments.empty())
+		{
+			return;
+		}
+
+		multisampleBuffer.Bind();
+		for (const char* name : { "color", "depth", "velocity" })
+		{
+			if (multisampleBuffer.attachments.contains(name))
+			{
+				frameBuffer::attachment_t& attachment = multisampleBuffer.attachments[name];
+				attachment.Resize(glm::ivec3(resolution, 1));
+				attachment.Initialize(attachment.FBODesc.attachmentFormat);
+			}
+		}
+		frameBuffer::Unbind();
+	}
+
+	void SetS2x(const bool& isS2x)
+	{
+		if (isS2x)
+		{
+			InitializeMultisampleBuffer();
+			const glm::ivec3 dimensions = geometryBuffer.attachments["color"].FBODesc.dimensions;
+			ResizeMultisampleBuffer(glm::ivec2(dimensions.x, dimensions.y));
+		}
+
+		useS2x = isS2x;
+		glState_t::Get().SetEnabled(GL_MULTISAMPLE, useS2x);
+	}
+
+	//where the geometry pass draws. the multisampled copy when S2x is on
+	void BindGeometryTarget()
+	{
+		useS2x ? multisampleBuffer.Bind() : geometryBuffer.Bind();
+	}
+
+	//edge detection, blending weights and neighborhood blending, once for SMAA 1x or once per sample for S2x
+	void SMAAPasses()
+	{
+		if (!useS2x)
+		{
+			EdgeDetectionPass();
+			BlendingWeightsPass();
+			SMAAPass();
+			return;
+		}
+
+		for (GLuint sampleIter = 0; sampleIter < numS2xSamples; sampleIter++)
+		{
+			SMAASettings.data.sampleIndex = (int32_t)sampleIter;
+			SMAASettings.data.subsampleIndex = subsampleIndices[sampleIter];
+			SMAASettings.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+
+			SeparateSamplePass();
+
+			//edge detection only writes where it finds edges, so the first sample's results have to go
+			if (sampleIter > 0)
+			{
+				ClearSMAATargets();
+				glState_t::Get().SetEnabled(GL_BLEND, true);
+				glState_t::Get().BlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+				TinyExtender::glBlendColor(0.0f, 0.0f, 0.0f, 1.0f / (float)(sampleIter + 1));
+			}
+
+			EdgeDetectionPass();
+			BlendingWeightsPass();
+			SMAAPass();
+			glState_t::Get().SetEnabled(GL_BLEND, false);
+		}
+
+		SMAASettings.data.sampleIndex = 0;
+		SMAASettings.data.subsampleIndex = 0;
+	}
+
+	//pulls one sample of the multisampled geometry pass into the regular geometry buffer, depth included
+	void SeparateSamplePass()
+	{
+		geometryBuffer.Bind();
+		SetGeometryDrawBuffers();
+
+		multisampleBuffer.attachments["color"].SetActive(0);
+		multisampleBuffer.attachments["depth"].SetActive(1);
+		//the sampler has to see a multisample texture either way, it's only written out when there's a velocity target
+		multisampleBuffer.attachments[useVelocity ? "velocity" : "color"].SetActive(2);
+
+		const glm::ivec3 dimensions = geometryBuffer.attachments["color"].FBODesc.dimensions;
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().UseProgram(separateProgram->handle);
+		glState_t::Get().Viewport(0, 0, dimensions.x, dimensions.y);
+		glState_t::Get().DepthFunc(GL_ALWAYS);
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		glState_t::Get().DepthFunc(GL_LESS);
+
+		frameBuffer::Unbind();
+	}
 
-	void Update() override
+	void SetGeometryDrawBuffers()
 	{
-		manager->PollForEvents();
-		if (lockedFrameRate > 0)
+		if (useVelocity)
 		{
-			clock.UpdateClockFixed(lockedFrameRate);
+			const GLenum drawBuffers[2] = { geometryBuffer.attachments["color"].FBODesc.attachmentFormat, geometryBuffer.attachments["velocity"].FBODesc.attachmentFormat };
+			glState_t::Get().DrawBuffers(2, drawBuffers);
 		}
+
 		else
 		{
-			clock.UpdateClockAdaptive();
+			glState_t::Get().DrawBuffers(1, &geometryBuffer.attachments["color"].FBODesc.attachmentFormat);
 		}
+	}
 
-		defaultPayload.data.deltaTime = (float)clock.GetDeltaTime();
-		defaultPayload.data.totalTime = (float)clock.GetTotalTime();
-		defaultPayload.data.framesPerSec = (float)(1.0 / clock.GetDeltaTime());
-		defaultPayload.data.totalFrames++;
-		defaultPayload.data.resolution = camera.resolution;
+	int currentTexture = 0;
+	bool enableCompare = true;
+
+	//SMAASettings is edited from the GUI so it belongs to the render thread along with the upload
+	void UpdateUniforms() override
+	{
+		defaultPayload.data.deltaTime = (float)renderState.deltaTime;
+		defaultPayload.data.totalTime = (float)renderState.totalTime;
+		defaultPayload.data.framesPerSec = (float)(1.0 / renderState.deltaTime);
+		defaultPayload.data.totalFrames = renderState.totalFrames;
+		defaultPayload.data.resolution = renderCamera.resolution;
 
 		SMAASettings.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+
+		textureStreamer_t::Get().Update();
 	}
 
 	void UpdateDefaultBuffer()
 	{
-		camera.UpdateProjection();
-		defaultPayload.data.projection = camera.projection;
-		defaultPayload.data.view = camera.view;
-		defaultPayload.data.resolution = camera.resolution;
-		if (camera.currentProjectionType == camera_t::projection_e::perspective)
+		renderCamera.UpdateProjection();
+		defaultPayload.data.projection = renderCamera.projection;
+		defaultPayload.data.view = renderCamera.view;
+		defaultPayload.data.resolution = renderCamera.resolution;
+		if (renderCamera.currentProjectionType == camera_t::projection_e::perspective)
 		{
 			defaultPayload.data.translation = testModel.makeTransform();
+
+			//shifts the whole image by projectionJitter in NDC
+			defaultPayload.data.projection[2][0] -= projectionJitter.x;
+			defaultPayload.data.projection[2][1] -= projectionJitter.y;
+			defaultPayload.data.projectionJitter = projectionJitter;
+
+			//the perspective update happens once a frame, right before the geometry pass
+			if (!hasPreviousMatrices)
+			{
+				previousProjection = renderCamera.projection;
+				previousView = renderCamera.view;
+				previousTranslation = defaultPayload.data.translation;
+				hasPreviousMatrices = true;
+			}
+			defaultPayload.data.previousProjection = previousProjection;
+			defaultPayload.data.previousView = previousView;
+			defaultPayload.data.previousTranslation = previousTranslation;
+
+			previousProjection = renderCamera.projection;
+			previousView = renderCamera.view;
+			previousTranslation = defaultPayload.data.translation;
 		}
 
 		else
 		{
-			defaultPayload.data.translation = camera.translation;
+			defaultPayload.data.translation = renderCamera.translation;
 		}
-		defaultPayload.data.deltaTime = (float)clock.GetDeltaTime();
-		defaultPayload.data.totalTime = (float)clock.GetTotalTime();
-		defaultPayload.data.framesPerSec = (float)(1.0 / clock.GetDeltaTime());
+		defaultPayload.data.deltaTime = (float)renderState.deltaTime;
+		defaultPayload.data.totalTime = (float)renderState.totalTime;
+		defaultPayload.data.framesPerSec = (float)(1.0 / renderState.deltaTime);
 
 		defaultPayload.Update();
 		//defaultVertexBuffer.UpdateBuffer(defaultPayload.data.resolution);
@@ -212,15 +473,13 @@ protected:
 
 	void Draw() override
 	{
-		camera.ChangeProjection(camera_t::projection_e::perspective);
-		camera.Update();
+		renderCamera.ChangeProjection(camera_t::projection_e::perspective);
+		renderCamera.Update();
 		UpdateDefaultBuffer();
 
 		GeometryPass(); //render current scene with jitter
 		
-		EdgeDetectionPass();
-		BlendingWeightsPass();
-		SMAAPass();
+		SMAAPasses();
 
 		FinalPass(&SMAABuffer.attachments["SMAA"], &geometryBuffer.attachments["color"]);
 		
@@ -234,34 +493,25 @@ protected:
 
 	virtual void GeometryPass()
 	{
-		geometryBuffer.Bind();
+		BindGeometryTarget();
 
-		glDrawBuffers(1, &geometryBuffer.attachments["color"].FBODesc.attachmentFormat);
+		SetGeometryDrawBuffers();
 
-		//we just need the first LOd so only do the first 3 meshes
-		for (size_t iter = 0; iter < 1; iter++)
-		{
-			if (testModel.meshes[iter].isCollision)
-			{
-				continue;
-			}
-
-			testModel.meshes[iter].textures[0].SetActive(0);
-			//add the previous depth?
-
-			glBindVertexArray(testModel.meshes[iter].vertexArrayHandle);
-			glUseProgram(geometryProgram->handle);
+		testModel.SelectLODs(renderCamera.view, renderCamera.projection, glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height));
+		geometryArena.ApplyLODs(testModel);
 
-			glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().UseProgram(geometryProgram->handle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 
-			if (wireframe)
-			{
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-			}
-			glDrawElements(GL_TRIANGLES, testModel.meshes[iter].indices.size(), GL_UNSIGNED_INT, nullptr);
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		if (wireframe)
+		{
+			glState_t::Get().PolygonMode(GL_LINE);
 		}
 
+		//every visible mesh in one go
+		geometryArena.Draw(geometryProgram->handle);
+		glState_t::Get().PolygonMode(GL_FILL);
+
 		frameBuffer::Unbind();
 	}
 
@@ -269,14 +519,14 @@ protected:
 	{
 		edgesBuffer.Bind();
 
-		glDrawBuffers(1, &edgesBuffer.attachments["edge"].FBODesc.attachmentFormat);
+		glState_t::Get().DrawBuffers(1, &edgesBuffer.attachments["edge"].FBODesc.attachmentFormat);
 
 		geometryBuffer.attachments["color"].SetActive(0);//color
 		geometryBuffer.attachments["depth"].SetActive(1);//depth
 
-		glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-		glUseProgram(edgeDetectionProgram->handle);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().UseProgram(edgeDetectionProgram->handle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 
 		frameBuffer::Unbind();
@@ -286,15 +536,15 @@ protected:
 	{
 		weightsBuffer.Bind();
 
-		glDrawBuffers(1, &weightsBuffer.attachments["blend"].FBODesc.attachmentFormat);
+		glState_t::Get().DrawBuffers(1, &weightsBuffer.attachments["blend"].FBODesc.attachmentFormat);
 
 		edgesBuffer.attachments["edge"].SetActive(0);
 		SMAAArea.SetActive(1);
 		SMAASearch.SetActive(2);
 
-		glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-		glUseProgram(blendingWeightProgram->handle);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().UseProgram(blendingWeightProgram->handle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 
 		frameBuffer::Unbind();
@@ -303,15 +553,15 @@ protected:
 	virtual void SMAAPass()
 	{
 		SMAABuffer.Bind();
-		glDrawBuffers(1, &SMAABuffer.attachments["SMAA"].FBODesc.attachmentFormat);
+		glState_t::Get().DrawBuffers(1, &SMAABuffer.attachments["SMAA"].FBODesc.attachmentFormat);
 
 		//current frame
 		geometryBuffer.attachments["color"].SetActive(0); // color
 		weightsBuffer.attachments["blend"].SetActive(1); //blending weights
 
-		glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-		glUseProgram(SMAAProgram->handle);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().UseProgram(SMAAProgram->handle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 
 		frameBuffer::Unbind();
@@ -322,17 +572,17 @@ protected:
 		//draw directly to backbuffer
 		tex1->SetActive(0);
 		
-		glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		if (enableCompare)
 		{
 			tex2->SetActive(1);
-			glUseProgram(compareProgram->handle);
+			glState_t::Get().UseProgram(compareProgram->handle);
 		}
 
 		else
 		{
-			glUseProgram(finalProgram->handle);
+			glState_t::Get().UseProgram(finalProgram->handle);
 		}
 	
 		glDrawArrays(GL_TRIANGLES, 0, 6);
@@ -384,10 +634,35 @@ protected:
 		glClear(GL_DEPTH_BUFFER_BIT);
 		frameBuffer::Unbind();
 
+		//nothing drawn there means nothing moved
+		if (useVelocity)
+		{
+			glClearTexImage(geometryBuffer.attachments["velocity"].GetHandle(), 0, GL_RG, GL_FLOAT, nullptr);
+		}
+
 		SMAABuffer.Bind();
 		frameBuffer::ClearTexture(SMAABuffer.attachments["SMAA"], value_ptr(clearColor2));
 		frameBuffer::Unbind();
 
+		if (useS2x)
+		{
+			multisampleBuffer.Bind();
+			SetGeometryDrawBuffers();
+			frameBuffer::ClearTexture(multisampleBuffer.attachments["color"], value_ptr(clearColor));
+			glClear(GL_DEPTH_BUFFER_BIT);
+			frameBuffer::Unbind();
+
+			if (useVelocity)
+			{
+				glClearTexImage(multisampleBuffer.attachments["velocity"].GetHandle(), 0, GL_RG, GL_FLOAT, nullptr);
+			}
+		}
+
+		ClearSMAATargets();
+	}
+
+	void ClearSMAATargets()
+	{
 		edgesBuffer.Bind();
 		frameBuffer::ClearTexture(edgesBuffer.attachments["edge"], value_ptr(clearColor2));
 		frameBuffer::Unbind();
@@ -399,32 +674,38 @@ protected:
 
 	virtual void ResizeBuffers(const glm::ivec2 resolution)
 	{
-		for (auto val : geometryBuffer.attachments | std::views::values)
-		{
-			val.Resize(glm::ivec3(resolution, 1));
-		}
+		geometryBuffer.Resize(glm::ivec3(resolution, 1));
 
 		edgesBuffer.attachments["edge"].Resize(glm::ivec3(resolution, 1));
 		weightsBuffer.attachments["blend"].Resize(glm::ivec3(resolution, 1));
 		SMAABuffer.attachments["SMAA"].Resize(glm::ivec3(resolution, 1));
+		ResizeMultisampleBuffer(resolution);
 	}
 
 	void HandleWindowResize(const tWindow* window, const vec2_t<uint16_t>& dimensions) override
 	{
-		defaultPayload.data.resolution = glm::ivec2(dimensions.width, dimensions.height);
-		ResizeBuffers(glm::ivec2(dimensions.x, dimensions.y));
+		const glm::ivec2 resolution = glm::ivec2(dimensions.width, dimensions.height);
+		DeferToRenderThread([this, resolution]()
+		{
+			defaultPayload.data.resolution = resolution;
+			ResizeBuffers(resolution);
+		});
 	}
 
 	void HandleMaximize(const tWindow* window) override
 	{
-		defaultPayload.data.resolution = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
-		ResizeBuffers(defaultPayload.data.resolution);
+		const glm::ivec2 resolution = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		DeferToRenderThread([this, resolution]()
+		{
+			defaultPayload.data.resolution = resolution;
+			ResizeBuffers(resolution);
+		});
 	}
 
 	void InitializeUniforms() override
 	{
 		defaultPayload = bufferHandler_t<defaultUniformBuffer>(camera);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 
 		defaultPayload.data.resolution = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		defaultPayload.data.projection = camera.projection;
@@ -442,6 +723,12 @@ protected:
 		if (ImGui::BeginTabItem("SMAA Settings"))
 		{
 			ImGui::Checkbox("enable Compare", &enableCompare);
+
+			bool isS2x = useS2x;
+			if (ImGui::Checkbox("S2x", &isS2x))
+			{
+				SetS2x(isS2x);
+			}
 			ImGui::SliderFloat("threshold", &SMAASettings.data.threshold, 0.001f, 1.0f, "%0.5f");
 			ImGui::SliderFloat("contrast adaption factor", &SMAASettings.data.contrastAdaptationFactor, 0.1f, 5.0f, "0.5f");
 			ImGui::SliderInt("max search steps", &SMAASettings.data.maxSearchSteps, 0, 255);
@@ -459,6 +746,22 @@ protected:
 				case 2: SMAASettings.data.edgeDetectionMode = (int32_t)EdgeDetectionMode_e::depth; break;
 				default: break;
 			}
+
+			//depth mode already is the predicate
+			ImGui::BeginDisabled(SMAASettings.data.edgeDetectionMode == (int32_t)EdgeDetectionMode_e::depth);
+			bool usePredication = SMAASettings.data.usePredication != 0;
+			if (ImGui::Checkbox("predication", &usePredication))
+			{
+				SMAASettings.data.usePredication = usePredication ? 1 : 0;
+			}
+
+			if (usePredication)
+			{
+				ImGui::SliderFloat("predication threshold", &SMAASettings.data.predicationThreshold, 0.0001f, 0.1f, "%0.5f");
+				ImGui::SliderFloat("predication scale", &SMAASettings.data.predicationScale, 1.0f, 5.0f);
+				ImGui::SliderFloat("predication strength", &SMAASettings.data.predicationStrength, 0.0f, 1.0f);
+			}
+			ImGui::EndDisabled();
 			ImGui::EndTabItem();
 		}
 	}
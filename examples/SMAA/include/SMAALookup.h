@@ -0,0 +1,449 @@
+#pragma once
+
+//what the area and search textures get built for. both change the pixels, so both go into the cache name
+struct SMAALookupSettings_t
+{
+	//how far the output stretches the SMAA result along its reduced axis. 1 = native resolution, same as the reference textures
+	float		stretch = 1.0f;
+	//rows bottom first, for shaders that address the textures the OpenGL way up. the SMAA shaders here use D3D addressing
+	bool		isFlipped = false;
+
+	bool operator==(const SMAALookupSettings_t&) const = default;
+};
+
+//builds SMAA's area and search lookup textures on the CPU instead of loading the pre-baked images.
+//a port of AreaTex.py and SearchTex.py from the SMAA reference. patterns are generated in parallel on the
+//thread pool and the results are kept under cooked/SMAA so later runs just read them back
+class SMAALookup_t
+{
+public:
+
+	static constexpr GLuint		areaWidth = 160;
+	static constexpr GLuint		areaHeight = 560;
+	static constexpr GLuint		searchWidth = 64;
+	static constexpr GLuint		searchHeight = 16;
+
+	//RG8, areaWidth * areaHeight texels
+	static std::vector<uint8_t> GenerateArea(const SMAALookupSettings_t& settings)
+	{
+		std::vector<uint8_t> pixels(areaWidth * areaHeight * 2, 0);
+
+		//one job per pattern per subsample offset, each writes its own block so nothing is shared
+		std::vector<std::future<void>> jobs;
+		for (GLuint offsetIter = 0; offsetIter < orthoOffsets.size(); offsetIter++)
+		{
+			for (GLuint pattern = 0; pattern < 16; pattern++)
+			{
+				jobs.push_back(threadPool_t::Get().Enqueue([&pixels, settings, offsetIter, pattern]()
+				{
+					const glm::uvec2 origin = glm::uvec2(orthoBlocks[pattern] * (GLint)orthoSize) + glm::uvec2(0, offsetIter * 80);
+					for (GLuint y = 0; y < orthoSize; y++)
+					{
+						for (GLuint x = 0; x < orthoSize; x++)
+						{
+							//distances are stored square rooted, the shader squares them back
+							const glm::vec2 area = AreaOrtho(pattern, (float)(x * x), (float)(y * y), orthoOffsets[offsetIter], settings.stretch);
+							WriteTexel(pixels, origin + glm::uvec2(x, y), area);
+						}
+					}
+				}));
+			}
+		}
+
+		for (GLuint offsetIter = 0; offsetIter < diagOffsets.size(); offsetIter++)
+		{
+			for (GLuint pattern = 0; pattern < 16; pattern++)
+			{
+				jobs.push_back(threadPool_t::Get().Enqueue([&pixels, offsetIter, pattern]()
+				{
+					const glm::uvec2 origin = glm::uvec2(diagBlocks[pattern] * (GLint)diagSize) + glm::uvec2(80, offsetIter * 80);
+					for (GLuint y = 0; y < diagSize; y++)
+					{
+						for (GLuint x = 0; x < diagSize; x++)
+						{
+							const glm::vec2 area = AreaDiag(pattern, (float)x, (float)y, diagOffsets[offsetIter]);
+							WriteTexel(pixels, origin + glm::uvec2(x, y), area);
+						}
+					}
+				}));
+			}
+		}
+
+		for (auto& job : jobs)
+		{
+			job.get();
+		}
+
+		if (settings.isFlipped)
+		{
+			FlipRows(pixels, areaWidth * 2, areaHeight);
+		}
+		return pixels;
+	}
+
+	//R8, searchWidth * searchHeight texels
+	static std::vector<uint8_t> GenerateSearch(const SMAALookupSettings_t& settings)
+	{
+		//the search texture is indexed by a bilinear fetch of four edges, so every value it can be sampled at is
+		//one of 16 combinations. e0..e3 weighted 1, 3, 7, 21 gives the fetch in 32nds
+		std::array<int, 33> edgesFromFetch;
+		edgesFromFetch.fill(-1);
+		for (int edges = 0; edges < 16; edges++)
+		{
+			edgesFromFetch[(edges & 1) * 1 + ((edges >> 1) & 1) * 3 + ((edges >> 2) & 1) * 7 + ((edges >> 3) & 1) * 21] = edges;
+		}
+
+		//the full table is 66x33 (left deltas then right deltas), cropped to the 64x16 the shader reads and flipped
+		std::vector<uint8_t> pixels(searchWidth * searchHeight, 0);
+		for (GLuint row = 0; row < searchHeight; row++)
+		{
+			const int fetchY = 32 - (int)row;
+			for (GLuint column = 0; column < searchWidth; column++)
+			{
+				const bool isRight = column >= 33;
+				const int fetchX = isRight ? (int)column - 33 : (int)column;
+				if (edgesFromFetch[fetchX] < 0 || edgesFromFetch[fetchY] < 0)
+				{
+					continue;
+				}
+
+				const int delta = isRight ? DeltaRight(edgesFromFetch[fetchX], edgesFromFetch[fetchY]) : DeltaLeft(edgesFromFetch[fetchX], edgesFromFetch[fetchY]);
+				//127 per step to use the range, the shader scales it back by 255 / 127
+				pixels[row * searchWidth + column] = (uint8_t)(127 * delta);
+			}
+		}
+
+		if (settings.isFlipped)
+		{
+			FlipRows(pixels, searchWidth, searchHeight);
+		}
+		return pixels;
+	}
+
+	//e.g. cooked/SMAA/AreaTex_s1.00.dds. anything that changes the pixels goes in the name
+	static std::string GetCachePath(const char* name, const SMAALookupSettings_t& settings)
+	{
+		char fileName[64] = {};
+		snprintf(fileName, sizeof(fileName), "cooked/SMAA/%s_s%.2f%s.dds", name, settings.stretch, settings.isFlipped ? "_flipped" : "");
+		return fileName;
+	}
+
+	//cached copy if there is one with the right size, otherwise generates it and writes it out for next time.
+	//generation waits on the thread pool, so don't call this from inside a job
+	static gli::texture2d Load(const char* name, const SMAALookupSettings_t& settings, const gli::format& format, const glm::uvec2& dimensions,
+		std::vector<uint8_t>(*generate)(const SMAALookupSettings_t&))
+	{
+		const std::string cachePath = ASSET_DIR + GetCachePath(name, settings);
+		const assetFile_t cacheFile = virtualFileSystem_t::Get().Open(GetCachePath(name, settings));
+		if (cacheFile.IsValid())
+		{
+			gli::texture2d cached(gli::load(cacheFile.GetData(), cacheFile.GetSize()));
+			if (!cached.empty() && cached.format() == format && glm::uvec2(cached.extent()) == dimensions)
+			{
+				return cached;
+			}
+		}
+
+		const std::vector<uint8_t> pixels = generate(settings);
+		gli::texture2d lookup(format, gli::extent2d(dimensions.x, dimensions.y), 1);
+		memcpy(lookup.data(), pixels.data(), pixels.size());
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), error);
+		if (error || !gli::save_dds(lookup, cachePath))
+		{
+			printf("couldn't write SMAA lookup cache: %s \n", cachePath.c_str());
+		}
+		return lookup;
+	}
+
+	static gli::texture2d LoadArea(const SMAALookupSettings_t& settings)
+	{
+		return Load("AreaTex", settings, gli::FORMAT_RG8_UNORM_PACK8, glm::uvec2(areaWidth, areaHeight), &GenerateArea);
+	}
+
+	static gli::texture2d LoadSearch(const SMAALookupSettings_t& settings)
+	{
+		return Load("SearchTex", settings, gli::FORMAT_R8_UNORM_PACK8, glm::uvec2(searchWidth, searchHeight), &GenerateSearch);
+	}
+
+private:
+
+	static constexpr GLuint		orthoSize = 16;
+	static constexpr GLuint		diagSize = 20;
+	static constexpr GLuint		diagSamples = 30;
+	static constexpr float		smoothMaxDistance = 32.0f;
+
+	static constexpr std::array<float, 7> orthoOffsets = { 0.0f, -0.25f, 0.25f, -0.125f, 0.125f, -0.375f, 0.375f };
+	static constexpr std::array<glm::vec2, 5> diagOffsets = { glm::vec2(0.0f, 0.0f), glm::vec2(0.25f, -0.25f), glm::vec2(-0.25f, 0.25f),
+		glm::vec2(0.125f, -0.125f), glm::vec2(-0.125f, 0.125f) };
+
+	//where each pattern's block sits, in blocks. the shader gets there from the fetched edge values
+	static constexpr std::array<glm::ivec2, 16> orthoBlocks = { glm::ivec2(0, 0), glm::ivec2(3, 0), glm::ivec2(0, 3), glm::ivec2(3, 3),
+		glm::ivec2(1, 0), glm::ivec2(4, 0), glm::ivec2(1, 3), glm::ivec2(4, 3), glm::ivec2(0, 1), glm::ivec2(3, 1), glm::ivec2(0, 4), glm::ivec2(3, 4),
+		glm::ivec2(1, 1), glm::ivec2(4, 1), glm::ivec2(1, 4), glm::ivec2(4, 4) };
+	static constexpr std::array<glm::ivec2, 16> diagBlocks = { glm::ivec2(0, 0), glm::ivec2(1, 0), glm::ivec2(0, 2), glm::ivec2(1, 2),
+		glm::ivec2(2, 0), glm::ivec2(3, 0), glm::ivec2(2, 2), glm::ivec2(3, 2), glm::ivec2(0, 1), glm::ivec2(1, 1), glm::ivec2(0, 3), glm::ivec2(1, 3),
+		glm::ivec2(2, 1), glm::ivec2(3, 1), glm::ivec2(2, 3), glm::ivec2(3, 3) };
+
+	static void WriteTexel(std::vector<uint8_t>& pixels, const glm::uvec2& texel, const glm::vec2& area)
+	{
+		const size_t index = (texel.y * areaWidth + texel.x) * 2;
+		pixels[index] = (uint8_t)std::round(glm::clamp(area.x, 0.0f, 1.0f) * 255.0f);
+		pixels[index + 1] = (uint8_t)std::round(glm::clamp(area.y, 0.0f, 1.0f) * 255.0f);
+	}
+
+	static void FlipRows(std::vector<uint8_t>& pixels, const size_t& rowSize, const size_t& numRows)
+	{
+		for (size_t row = 0; row < numRows / 2; row++)
+		{
+			std::swap_ranges(pixels.begin() + row * rowSize, pixels.begin() + (row + 1) * rowSize, pixels.begin() + (numRows - 1 - row) * rowSize);
+		}
+	}
+
+	//area under the line p1 -> p2 for the pixel x..x+1. x = area below the edge, y = above
+	static glm::vec2 AreaUnderLine(const glm::vec2& p1, const glm::vec2& p2, const float& x)
+	{
+		const glm::vec2 d = p2 - p1;
+		const float x1 = x;
+		const float x2 = x + 1.0f;
+		const float y1 = p1.y + d.y * (x1 - p1.x) / d.x;
+		const float y2 = p1.y + d.y * (x2 - p1.x) / d.x;
+
+		const bool isInside = (x1 >= p1.x && x1 < p2.x) || (x2 > p1.x && x2 <= p2.x);
+		if (!isInside)
+		{
+			return glm::vec2(0.0f);
+		}
+
+		const bool isTrapezoid = std::copysign(1.0f, y1) == std::copysign(1.0f, y2) || std::abs(y1) < 1e-4f || std::abs(y2) < 1e-4f;
+		if (isTrapezoid)
+		{
+			const float a = (y1 + y2) / 2.0f;
+			return (a < 0.0f) ? glm::vec2(std::abs(a), 0.0f) : glm::vec2(0.0f, std::abs(a));
+		}
+
+		//the line crosses the edge inside the pixel, so it's two triangles on opposite sides
+		const float crossing = -p1.y * d.x / d.y + p1.x;
+		const float fraction = crossing - std::floor(crossing);
+		const float a1 = (crossing > p1.x) ? y1 * fraction / 2.0f : 0.0f;
+		const float a2 = (crossing < p2.x) ? y2 * (1.0f - fraction) / 2.0f : 0.0f;
+		const float dominant = (std::abs(a1) > std::abs(a2)) ? a1 : -a2;
+		return (dominant < 0.0f) ? glm::vec2(std::abs(a1), std::abs(a2)) : glm::vec2(std::abs(a2), std::abs(a1));
+	}
+
+	//short u-shapes get rounded off, fading out by smoothMaxDistance output pixels
+	static void SmoothArea(const float& d, glm::vec2& a1, glm::vec2& a2, const float& stretch)
+	{
+		const glm::vec2 b1 = glm::sqrt(a1 * 2.0f) * 0.5f;
+		const glm::vec2 b2 = glm::sqrt(a2 * 2.0f) * 0.5f;
+		const float p = glm::clamp(d * stretch / smoothMaxDistance, 0.0f, 1.0f);
+		a1 = glm::mix(b1, a1, p);
+		a2 = glm::mix(b2, a2, p);
+	}
+
+	//patterns are the crossing edges at each end. bit 0 = left end goes down, 1 = right end down, 2 = left up, 3 = right up
+	static glm::vec2 AreaOrtho(const GLuint& pattern, const float& left, const float& right, const float& offset, const float& stretch)
+	{
+		const float d = left + right + 1.0f;
+		const float o1 = 0.5f + offset;
+		const float o2 = 0.5f + offset - 1.0f;
+
+		switch (pattern)
+		{
+			case 1:
+			{
+				//only the crossing edge side gets offset, so it converges with the unfiltered pattern 0
+				return (left <= right) ? AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d / 2.0f, 0.0f), left) : glm::vec2(0.0f);
+			}
+
+			case 2:
+			{
+				return (left >= right) ? AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o2), left) : glm::vec2(0.0f);
+			}
+
+			case 3:
+			{
+				glm::vec2 a1 = AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d / 2.0f, 0.0f), left);
+				glm::vec2 a2 = AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o2), left);
+				SmoothArea(d, a1, a2, stretch);
+				return a1 + a2;
+			}
+
+			case 4:
+			{
+				return (left <= right) ? AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d / 2.0f, 0.0f), left) : glm::vec2(0.0f);
+			}
+
+			case 6:
+			{
+				//z-shapes only turn up in very particular situations
+				if (std::abs(offset) > 0.0f)
+				{
+					const glm::vec2 a1 = AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d, o2), left);
+					const glm::vec2 a2 = AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d / 2.0f, 0.0f), left) +
+						AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o2), left);
+					return (a1 + a2) / 2.0f;
+				}
+				return AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d, o2), left);
+			}
+
+			case 7:
+			{
+				return AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d, o2), left);
+			}
+
+			case 8:
+			{
+				return (left >= right) ? AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o1), left) : glm::vec2(0.0f);
+			}
+
+			case 9:
+			{
+				if (std::abs(offset) > 0.0f)
+				{
+					const glm::vec2 a1 = AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d, o1), left);
+					const glm::vec2 a2 = AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d / 2.0f, 0.0f), left) +
+						AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o1), left);
+					return (a1 + a2) / 2.0f;
+				}
+				return AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d, o1), left);
+			}
+
+			case 11:
+			{
+				return AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d, o1), left);
+			}
+
+			case 12:
+			{
+				glm::vec2 a1 = AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d / 2.0f, 0.0f), left);
+				glm::vec2 a2 = AreaUnderLine(glm::vec2(d / 2.0f, 0.0f), glm::vec2(d, o1), left);
+				SmoothArea(d, a1, a2, stretch);
+				return a1 + a2;
+			}
+
+			case 13:
+			{
+				return AreaUnderLine(glm::vec2(0.0f, o2), glm::vec2(d, o1), left);
+			}
+
+			case 14:
+			{
+				return AreaUnderLine(glm::vec2(0.0f, o1), glm::vec2(d, o2), left);
+			}
+
+			//straight lines and crosses don't get filtered
+			default: return glm::vec2(0.0f);
+		}
+	}
+
+	//fraction of the pixel at p on the positive side of p1 -> p2, brute force sampled
+	static float AreaUnderDiagonal(const glm::vec2& p1, const glm::vec2& p2, const glm::vec2& p)
+	{
+		if (p1 == p2)
+		{
+			return 1.0f;
+		}
+
+		const glm::vec2 middle = (p1 + p2) / 2.0f;
+		const float a = p2.y - p1.y;
+		const float b = p1.x - p2.x;
+
+		GLuint numInside = 0;
+		for (GLuint x = 0; x < diagSamples; x++)
+		{
+			for (GLuint y = 0; y < diagSamples; y++)
+			{
+				const glm::vec2 samplePoint = p + glm::vec2((float)x, (float)y) / (float)(diagSamples - 1);
+				numInside += (a * (samplePoint.x - middle.x) + b * (samplePoint.y - middle.y) > 0.0f) ? 1 : 0;
+			}
+		}
+		return (float)numInside / (float)(diagSamples * diagSamples);
+	}
+
+	//covers the pixel and the one opposite it along the diagonal
+	static glm::vec2 AreaDiagLine(const GLuint& pattern, glm::vec2 p1, glm::vec2 p2, const float& left, const glm::vec2& offset)
+	{
+		if (diagBlocks[pattern].x > 0)
+		{
+			p1 += offset;
+		}
+
+		if (diagBlocks[pattern].y > 0)
+		{
+			p2 += offset;
+		}
+
+		const float a1 = AreaUnderDiagonal(p1, p2, glm::vec2(1.0f, 0.0f) + glm::vec2(left));
+		const float a2 = AreaUnderDiagonal(p1, p2, glm::vec2(1.0f, 1.0f) + glm::vec2(left));
+		return glm::vec2(1.0f - a1, a2);
+	}
+
+	//the ends of diagonal lines aren't known the way orthogonal ones are, so where an end could go either way
+	//both possibilities get blended. unlike orthogonal lines the pattern without crossing edges is filtered too
+	static glm::vec2 AreaDiag(const GLuint& pattern, const float& left, const float& right, const glm::vec2& offset)
+	{
+		const float d = left + right + 1.0f;
+		const auto area = [&](const glm::vec2& p1, const glm::vec2& p2)
+		{
+			return AreaDiagLine(pattern, p1, p2 + glm::vec2(d), left, offset);
+		};
+
+		switch (pattern)
+		{
+			case 0: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 1: return (area(glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 0.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 2: return (area(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 3: return area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f));
+			case 4: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 0.0f)) + area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 5: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 0.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 6: return area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 0.0f));
+			case 7: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 0.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 8: return (area(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f))) / 2.0f;
+			case 9: return area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f));
+			case 10: return (area(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 11: return (area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			case 12: return area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f));
+			case 13: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f))) / 2.0f;
+			case 14: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+			default: return (area(glm::vec2(1.0f, 1.0f), glm::vec2(1.0f, 1.0f)) + area(glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 0.0f))) / 2.0f;
+		}
+	}
+
+	//edges are e0 e1 on the row above, e2 e3 on the current row. bit n = en
+
+	//how much further a search to the left gets to go on its last step
+	static int DeltaLeft(const int& left, const int& top)
+	{
+		int d = 0;
+		//there's an edge, keep going
+		if (top & 8)
+		{
+			d++;
+		}
+
+		//there's another edge and no crossing edges, keep going
+		if (d == 1 && (top & 4) && !(left & 2) && !(left & 8))
+		{
+			d++;
+		}
+		return d;
+	}
+
+	static int DeltaRight(const int& left, const int& top)
+	{
+		int d = 0;
+		//there's an edge and no crossing edges, keep going
+		if ((top & 8) && !(left & 2) && !(left & 8))
+		{
+			d++;
+		}
+
+		if (d == 1 && (top & 4) && !(left & 1) && !(left & 4))
+		{
+			d++;
+		}
+		return d;
+	}
+};
@@ -1,8 +1,9 @@
 #include "SMAA.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 	SMAAScene exampleScene = SMAAScene();
+	exampleScene.ParseArguments(argc, argv);
 	exampleScene.Initialize();
 	exampleScene.Run();
 	//delete exampleScene;
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <random>
+
+#include "OAUpsampler.h"
+
+enum class placement_e
+{
+	grid = 0,		//spread out flat, lots of small copies. vertex heavy
+	scatter = 1,	//random positions, rotations and tints through a volume that grows with the count
+	stack = 2		//everything piled into one model's bounds so each pixel gets shaded over and over. fill heavy
+};
+
+//per instance, std430. matches instanceSettings in instanced.vert
+struct instanceData_t
+{
+	glm::mat4	transform = glm::mat4(1);
+	glm::vec4	tint = glm::vec4(1); //multiplied into the material colour
+};
+
+//the OA upsampler with the model drawn thousands of times over. the transforms and tints come out of an SSBO and
+//the instances are frustum culled on the GPU, which also writes the draws, so the CPU only issues one multi draw
+//per texture batch. everything after the geometry pass is the upsampler's, so its modes can be
+//compared against instance count and placement to see where dropping resolution stops paying off
+class instancedStressScene final : public OAUpsamplerScene
+{
+public:
+
+	instancedStressScene(const char* windowName = "Ziyad Barakat's portfolio (instanced stress)",
+		const camera_t& camera = camera_t(defaultWindowSize, defaultCameraSpeed, camera_t::projection_e::perspective),
+		const char* shaderConfigPath = SHADER_CONFIG_DIR,
+		const model_t& model = model_t("models/SoulSpear/SoulSpear.fbx")) : OAUpsamplerScene(windowName, camera, shaderConfigPath, model)
+	{
+		instanceBuffer = 0;
+		instanceCapacity = 0;
+		modelSphere = glm::vec4(0, 0, 0, 1);
+	}
+
+	void Initialize() override
+	{
+		OAUpsamplerScene::Initialize();
+
+		//one sphere around every mesh, instances get culled whole
+		glm::vec4 merged = glm::vec4(0);
+		for (const auto& lodChain : testModel.lodChains)
+		{
+			merged = (merged.w > 0.0f) ? model_t::MergeBoundingSpheres(merged, lodChain.boundingSphere) : lodChain.boundingSphere;
+		}
+		modelSphere = (merged.w > 0.0f) ? merged : glm::vec4(0, 0, 0, 1);
+
+		instanceCuller.Initialize(geometryArena, maxInstances, shaderProgramsMap["cullInstances"].handle, shaderProgramsMap["buildCommands"].handle);
+		useVisibleListLocation = glGetUniformLocation(geometryProgram->handle, "useVisibleList");
+
+		UpdateInstances();
+	}
+
+	void ShutDown(tWindow* window) override
+	{
+		instanceCuller.ShutDown();
+		glDeleteBuffers(1, &instanceBuffer);
+		instanceBuffer = 0;
+		instanceCapacity = 0;
+		OAUpsamplerScene::ShutDown(window);
+	}
+
+	//--instances <count>, --placement <grid|scatter|stack>, --nocull, and --nocount to draw the culled commands without
+	//glMultiDrawElementsIndirectCount
+	void ParseArguments(const int& argc, char* argv[]) override
+	{
+		OAUpsamplerScene::ParseArguments(argc, argv);
+		for (int iter = 1; iter < argc; iter++)
+		{
+			if (std::string_view(argv[iter]) == "--nocull")
+			{
+				useCulling = false;
+			}
+
+			else if (std::string_view(argv[iter]) == "--nocount")
+			{
+				useIndirectCount = false;
+			}
+		}
+
+		for (int iter = 1; iter < argc - 1; iter++)
+		{
+			if (std::string_view(argv[iter]) == "--instances")
+			{
+				numInstances = std::clamp(std::atoi(argv[iter + 1]), 1, (int)maxInstances);
+			}
+
+			else if (std::string_view(argv[iter]) == "--placement")
+			{
+				const std::string_view pattern = argv[iter + 1];
+				placement = (pattern == "scatter") ? placement_e::scatter : (pattern == "stack") ? placement_e::stack : placement_e::grid;
+			}
+		}
+	}
+
+protected:
+
+	static constexpr GLuint		maxInstances = 65536;
+	static constexpr GLuint		instanceBinding = instanceCuller_t::instanceBinding;
+
+	int							numInstances = 1024;
+	placement_e					placement = placement_e::grid;
+	float						spacing = 2.5f; //in model radii
+	uint32_t					seed = 1;
+	bool						useCulling = true;
+	bool						useIndirectCount = true;
+
+	GLuint						instanceBuffer;
+	GLuint						instanceCapacity;
+	glm::vec4					modelSphere;
+
+	instanceCuller_t			instanceCuller;
+	GLint						useVisibleListLocation = -1;
+
+	//culls once per frame ahead of the pass, the adaptive tiles then draw the same commands once per tile.
+	//the LODs get picked here first so the commands are built from this frame's, the pass picking them again changes nothing
+	void GeometryPass() override
+	{
+		if (useCulling)
+		{
+			testModel.SelectLODs(renderCamera.view, renderCamera.projection, glm::vec2(scaledResolution));
+			geometryArena.ApplyLODs(testModel);
+			instanceCuller.Cull(geometryArena, instanceBuffer, (GLuint)numInstances, modelSphere);
+		}
+
+		//once a frame rather than once per tile
+		glProgramUniform1ui(geometryProgram->handle, useVisibleListLocation, useCulling ? 1 : 0);
+		OAUpsamplerScene::GeometryPass();
+	}
+
+	void DrawGeometry() override
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, instanceBinding, instanceBuffer);
+
+		if (useCulling)
+		{
+			instanceCuller.Draw(geometryArena, useIndirectCount);
+		}
+
+		else
+		{
+			geometryArena.DrawInstanced((GLuint)numInstances);
+		}
+	}
+
+	//lays the instances out again and sends them over. the buffer only gets reallocated when it has to grow
+	void UpdateInstances()
+	{
+		const std::vector<instanceData_t> instances = BuildInstances();
+
+		if (instanceCapacity < instances.size())
+		{
+			glDeleteBuffers(1, &instanceBuffer);
+			instanceCapacity = (GLuint)instances.size();
+			glCreateBuffers(1, &instanceBuffer);
+			glNamedBufferStorage(instanceBuffer, sizeof(instanceData_t) * instanceCapacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+		}
+
+		glNamedBufferSubData(instanceBuffer, 0, sizeof(instanceData_t) * instances.size(), instances.data());
+	}
+
+	std::vector<instanceData_t> BuildInstances() const
+	{
+		std::vector<instanceData_t> instances(numInstances);
+		std::mt19937 generator(seed);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		const float step = modelSphere.w * spacing;
+		switch (placement)
+		{
+			case placement_e::grid:
+			{
+				//square-ish grid centred on the original model
+				const int columns = (int)std::ceil(std::sqrt((float)numInstances));
+				const float halfWidth = (float)(columns - 1) * step * 0.5f;
+				for (int instanceIter = 0; instanceIter < numInstances; instanceIter++)
+				{
+					const glm::vec3 position = glm::vec3((float)(instanceIter % columns) * step - halfWidth, 0.0f, (float)(instanceIter / columns) * step - halfWidth);
+					instances[instanceIter].transform = glm::translate(glm::mat4(1), position);
+				}
+				break;
+			}
+
+			case placement_e::scatter:
+			{
+				//same density whatever the count
+				const float halfWidth = std::cbrt((float)numInstances) * step * 0.5f;
+				for (auto& instance : instances)
+				{
+					const glm::vec3 position = (glm::vec3(unit(generator), unit(generator), unit(generator)) * 2.0f - 1.0f) * halfWidth;
+					const float angle = unit(generator) * glm::two_pi<float>();
+					instance.transform = glm::rotate(glm::translate(glm::mat4(1), position), angle, glm::vec3(0, 1, 0));
+					instance.tint = glm::vec4(glm::mix(glm::vec3(0.5f), glm::vec3(1.0f), glm::vec3(unit(generator), unit(generator), unit(generator))), 1.0f);
+				}
+				break;
+			}
+
+			case placement_e::stack:
+			{
+				//small offsets and turns so the copies don't z-fight but still cover the same pixels
+				for (auto& instance : instances)
+				{
+					const glm::vec3 position = (glm::vec3(unit(generator), unit(generator), unit(generator)) * 2.0f - 1.0f) * modelSphere.w * 0.1f;
+					const float angle = (unit(generator) * 2.0f - 1.0f) * 0.2f;
+					instance.transform = glm::rotate(glm::translate(glm::mat4(1), position), angle, glm::vec3(0, 1, 0));
+				}
+				break;
+			}
+		}
+		return instances;
+	}
+
+	void BuildGUI(tWindow* window, const ImGuiIO& io) override
+	{
+		OAUpsamplerScene::BuildGUI(window, io);
+		DrawInstanceSettings();
+	}
+
+	void DrawInstanceSettings()
+	{
+		if (ImGui::BeginTabItem("instances"))
+		{
+			bool isChanged = false;
+			isChanged |= ImGui::DragInt("count", &numInstances, 16.0f, 1, (int)maxInstances);
+
+			int placementPick = (int)placement;
+			const std::vector placementSettings = { "grid", "scatter", "stack" };
+			if (ImGui::ListBox("placement", &placementPick, placementSettings.data(), (int)placementSettings.size()))
+			{
+				placement = (placement_e)placementPick;
+				isChanged = true;
+			}
+
+			isChanged |= ImGui::SliderFloat("spacing (radii)", &spacing, 1.0f, 10.0f);
+
+			if (isChanged)
+			{
+				numInstances = std::clamp(numInstances, 1, (int)maxInstances);
+				UpdateInstances();
+			}
+
+			ImGui::Checkbox("GPU culling", &useCulling);
+			if (useCulling)
+			{
+				ImGui::BeginDisabled(!instanceCuller.IsCountAvailable());
+				ImGui::Checkbox("indirect count", &useIndirectCount);
+				ImGui::EndDisabled();
+			}
+
+			ImGui::Text("%u draws x %i instances", geometryArena.GetNumDraws(), numInstances);
+			ImGui::EndTabItem();
+		}
+	}
+};
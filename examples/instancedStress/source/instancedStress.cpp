@@ -0,0 +1,11 @@
+#include "instancedStress.h"
+
+int main(int argc, char* argv[])
+{
+	instancedStressScene exampleScene = instancedStressScene();
+	exampleScene.ParseArguments(argc, argv);
+	exampleScene.Initialize();
+	exampleScene.Run();
+
+	return 0;
+}
@@ -7,6 +7,23 @@
 
 using frameRates_t = enum {UNCAPPED = 0, THIRTY = 30, SIXTY = 60, NINETY = 90, ONETWENTY = 120, ONEFOURTYFOUR = 144};
 
+//everything the render thread needs from the simulation side for one frame.
+//written by Update on the main thread, read back on the render thread through frameSlots
+struct frameState_t
+{
+	camera_t		camera;
+	double			deltaTime = 0.0;
+	double			totalTime = 0.0;
+	uint32_t		totalFrames = 0;
+	glm::vec2		mousePosition = glm::vec2(0);
+
+	//the pacer lives on the main thread so the GUI only ever sees copies of its stats
+	double			frameTimeMs = 0.0;
+	double			frameTimeStdDevMs = 0.0;
+	double			frameJitterMs = 0.0;
+	int64_t			spinWindow = 0;
+};
+
 class scene
 {
 public:
@@ -25,6 +42,11 @@ public:
 		lockedFrameRate = 60;
 
 		manager = new windowManager();
+
+#if defined(TW_LINUX)
+		//xlib has to be told before anything else touches it that more than one thread will be making calls
+		XInitThreads();
+#endif
 		
 		windowSetting_t setting;
 		setting.name = windowName;
@@ -55,34 +77,50 @@ public:
 		delete defaultTimer;			defaultTimer = nullptr;
 	}
 
+	//the main thread polls input and steps the simulation while the render thread draws the frame before it.
+	//with useRenderThread off the same loop just renders inline, which is handy for debugging
 	virtual void Run()
 	{
+		if (useRenderThread)
+		{
+			StartRenderThread();
+		}
+
 		while (!window->GetShouldClose())
 		{
 			Update();
-			Draw();
+			PublishFrame();
+
+			if (!useRenderThread)
+			{
+				RenderFrame();
+			}
+			framePacer.Wait(lockedFrameRate);
 		}
+
+		StopRenderThread();
+		ShutDown(window);
 	}
 
 	virtual void Initialize()
 	{
 		te::InitializeExtensions();
+		glState_t::Get().Initialize();
 
-		if (glDebugMessageCallback == nullptr)
+		debugLogger_t::Get().Initialize();
+		textureStreamer_t::Get().Initialize();
+
+		//has to be in place before anything gets loaded, workers read from it without locking
+		if (useAssetPack)
 		{
-			printf("blarg \n");
+			virtualFileSystem_t::Get().Mount(std::string("packs/") + PROJECT_NAME + ".pak");
 		}
 
-		// Enable debug output
-		glEnable(GL_DEBUG_OUTPUT);
-		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-		glDebugMessageCallback(&OpenGLDebugCallback, nullptr);
-
 		LoadShaderProgramsFromConfigFile(&shaderProgramsMap);
 
 		defProgram = shaderProgramsMap[PROJECT_NAME]; //need a better way to automate this
 
-		glUseProgram(defProgram.handle);
+		glState_t::Get().UseProgram(defProgram.handle);
 
 		InitializeUniforms();
 		SetupCallbacks();
@@ -103,16 +141,42 @@ public:
 
 	}
 
-	void ShutDown(tWindow* window)
+	//back on the main thread with the context current. derived scenes free their own GL objects then call this
+	virtual void ShutDown(tWindow* window)
 	{
 		for (auto val : shaderProgramsMap | std::views::values)
 		{
 			ShutdownShaderProgram(val);
 		}
 
+		defaultPayload.ShutDown();
+		textureCache_t::Get().ShutDown();
+		textureStreamer_t::Get().ShutDown();
 		ImGUIInvalidateDeviceObject();
+		debugLogger_t::Get().ShutDown();
 		manager->ShutDown();
 	}
+
+	virtual void ParseArguments(const int& argc, char* argv[])
+	{
+		for (int iter = 1; iter < argc; iter++)
+		{
+			if (std::string_view(argv[iter]) == "--benchmark")
+			{
+				isBenchmark = true;
+			}
+
+			else if (std::string_view(argv[iter]) == "--stalls")
+			{
+				stallDetector_t::Get().isEnabled = true;
+			}
+
+			else if (std::string_view(argv[iter]) == "--loose")
+			{
+				useAssetPack = false;
+			}
+		}
+	}
 	
 protected:
 
@@ -123,11 +187,14 @@ protected:
 	tsl::robin_map<std::string, ShaderProgram_t>	shaderProgramsMap;
 
 	tinyClock_t										clock;
+	framePacer_t									framePacer;
 	vertexBuffer_t									defaultVertexBuffer;
 
 	bufferHandler_t<defaultUniformBuffer>			defaultPayload;
 
 	camera_t					camera;
+	glm::vec2					mousePosition = glm::vec2(0);
+	uint32_t					totalFrames = 0;
 	const char*					windowName;
 	ShaderProgram_t				defProgram;
 	const char*					shaderConfigPath;
@@ -145,11 +212,27 @@ protected:
 	GLuint						imGUIVBOHandle;
 	GLuint						imGUIVAOHandle;
 	GLuint						imGUIIBOHandle;
+	ImDrawVert*					imGUIVertexPtr;
+	ImDrawIdx*					imGUIIndexPtr;
+	size_t						imGUIVertexCapacity;
+	size_t						imGUIIndexCapacity;
+	bool						isDockBuilt = false;
 	int interval = 1;
 
 	bool						isGUIActive;
 	bool						wireframe;
 
+	//state the scene draws with. the GUI renderer puts these back when it's done rather than querying GL for them
+	bool						depthTestEnabled = false;
+
+	//--benchmark. no GUI at all, frame stats go to the console every benchmarkReportInterval frames
+	bool						isBenchmark = false;
+	uint32_t					benchmarkReportInterval = 240;
+
+	//mounts assets/packs/<project>.pak (built by assetPacker) when there is one. --loose skips it so edited
+	//shaders and textures get picked up without repacking
+	bool						useAssetPack = true;
+
 	bool						isFrameRateLocked;
 	int							lockedFrameRate = UNCAPPED;
 	std::vector<const char*>	frameRateSettings = { "none", "30", "60", "90", "120", "144" };
@@ -158,51 +241,218 @@ protected:
 
 	GPUTimer*					defaultTimer;
 
-	std::string					defaultDockName = "Default";
-	ImGuiID left_node, central_node;
+	//render side. renderCamera and renderState are only touched by the thread that owns the GL context
+	camera_t					renderCamera;
+	frameState_t				renderState;
+	bool						useRenderThread = true;
 
-	typedef std::pair<int32_t, std::string> debugTypeEntry;
-	static tsl::robin_map<int32_t, std::string> debugTypeLUT;
+	tripleBuffer_t											frameSlots;
+	std::array<frameState_t, tripleBuffer_t::numSlots>		frameStates;
+	commandQueue_t				renderCommands;
+	commandQueue_t				simCommands;
+	std::thread					renderThread;
+	std::mutex					frameMutex;
+	std::condition_variable		frameSignal;
+	std::atomic<bool>			isRenderThreadRunning = false;
 
-	typedef std::pair<int32_t, std::string> severityEntry;
-	static tsl::robin_map<int32_t, std::string> severityLUT;
-
-	typedef std::pair<int32_t, std::string> sourceTypeEntry;
-	static tsl::robin_map<int32_t, std::string> sourceTypeLUT;
+	std::string					defaultDockName = "Default";
+	ImGuiID left_node, central_node;
 
 	typedef std::pair<int32_t, ImGuiKey> keyMapEntry;
 	static tsl::robin_map<int32_t, ImGuiKey> keyMapLUT;
 
+	//main thread. no GL in here, anything the render side needs goes through WriteSnapshot
 	virtual void Update()
 	{
 		manager->PollForEvents();
+		simCommands.Execute();
 		camera.Update();
-		if (lockedFrameRate > 0)
+		//the frame cap is handled by framePacer in Run
+		clock.UpdateClockAdaptive();
+		totalFrames++;
+	}
+
+	//main thread. copy whatever the render thread needs for this frame into the slot
+	virtual void WriteSnapshot(const size_t& slot)
+	{
+		frameState_t& state = frameStates[slot];
+		state.camera = camera;
+		state.deltaTime = clock.GetDeltaTime();
+		state.totalTime = clock.GetTotalTime();
+		state.totalFrames = totalFrames;
+		state.mousePosition = mousePosition;
+		state.frameTimeMs = framePacer.GetMeanMs();
+		state.frameTimeStdDevMs = framePacer.GetStdDevMs();
+		state.frameJitterMs = framePacer.GetMaxJitterMs();
+		state.spinWindow = framePacer.spinWindow;
+	}
+
+	//render thread. pick up the newest published frame
+	virtual void ReadSnapshot(const size_t& slot)
+	{
+		renderState = frameStates[slot];
+		renderCamera = renderState.camera;
+	}
+
+	//render thread. per frame uniform uploads that used to live in Update
+	virtual void UpdateUniforms()
+	{
+		defaultPayload.data.totalFrames = renderState.totalFrames;
+		defaultPayload.data.deltaTime = (float)renderState.deltaTime;
+		defaultPayload.data.totalTime = (float)renderState.totalTime;
+		defaultPayload.data.framesPerSec = (float)(1.0 / renderState.deltaTime);
+		defaultPayload.data.mousePosition = renderState.mousePosition;
+		defaultPayload.data.projection = renderCamera.projection;
+		defaultPayload.data.view = renderCamera.view;
+		defaultPayload.data.translation = renderCamera.translation;
+
+		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_STATIC_DRAW);
+
+		textureStreamer_t::Get().Update();
+	}
+
+	//render thread
+	virtual void RenderFrame()
+	{
+		renderCommands.Execute();
+
 		{
-			clock.UpdateClockFixed(lockedFrameRate);
+			std::scoped_lock lock(frameMutex);
+			if (frameSlots.AcquireLatest())
+			{
+				ReadSnapshot(frameSlots.GetReadSlot());
+			}
 		}
+		frameSignal.notify_all();
+
+		UpdateUniforms();
+		Draw();
+
+		//lets the uniform rings know this frame's region is done with
+		bufferFrames_t::EndFrame();
+		glState_t::Get().EndFrame();
+		stallDetector_t::Get().EndFrame();
+
+		if (isBenchmark && renderState.totalFrames % benchmarkReportInterval == 0)
+		{
+			printf("frame %u \t %.3f ms \t std dev %.3f ms \t worst jitter %.3f ms \t GL state calls %u (%u skipped) \n", renderState.totalFrames, renderState.frameTimeMs,
+				renderState.frameTimeStdDevMs, renderState.frameJitterMs, glState_t::Get().GetIssuedLastFrame(), glState_t::Get().GetSkippedLastFrame());
+
+			for (const auto& site : stallDetector_t::Get().GetLastFrame())
+			{
+				printf("\tstall %s \t %s:%i \t %u calls \t %.3f ms \n", site.name, site.GetFileName(), site.line, site.numCalls, (double)site.timeNS / 1e6);
+			}
+		}
+	}
+
+	//hands the frame Update just built to the render thread. if the render thread hasn't picked up
+	//the last one yet we wait for it rather than racing ahead, so the two stay at most a frame apart
+	void PublishFrame()
+	{
+		WriteSnapshot(frameSlots.GetWriteSlot());
+
+		{
+			std::unique_lock lock(frameMutex);
+			if (useRenderThread)
+			{
+				frameSignal.wait(lock, [this]() { return !frameSlots.HasNewFrame() || !isRenderThreadRunning; });
+			}
+			frameSlots.Publish();
+		}
+		frameSignal.notify_all();
+	}
+
+	//GL work coming from the main thread (event handlers mostly). runs at the start of the next rendered frame
+	void DeferToRenderThread(std::function<void()>&& command)
+	{
+		if (useRenderThread)
+		{
+			renderCommands.Push(std::move(command));
+		}
+
 		else
 		{
-			clock.UpdateClockAdaptive();
-		}		
+			command();
+		}
+	}
 
-		defaultPayload.data.totalFrames++;
-		defaultPayload.data.deltaTime = (float)clock.GetDeltaTime();
-		defaultPayload.data.totalTime = (float)clock.GetTotalTime();
-		defaultPayload.data.framesPerSec = (float)(1.0 / clock.GetDeltaTime());
-		defaultPayload.data.projection = camera.projection;
-		defaultPayload.data.view = camera.view;
-		defaultPayload.data.translation = camera.translation;
+	//changes the GUI makes to main thread state (camera, frame cap). runs at the start of the next Update
+	void DeferToSimThread(std::function<void()>&& command)
+	{
+		if (useRenderThread)
+		{
+			simCommands.Push(std::move(command));
+		}
 
-		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_STATIC_DRAW);
+		else
+		{
+			command();
+		}
+	}
+
+	void StartRenderThread()
+	{
+		//a context can only be current on one thread at a time
+		ReleaseContext();
+		isRenderThreadRunning = true;
+		renderThread = std::thread(&scene::RenderThreadLoop, this);
+	}
+
+	void StopRenderThread()
+	{
+		if (!renderThread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::scoped_lock lock(frameMutex);
+			isRenderThreadRunning = false;
+		}
+		frameSignal.notify_all();
+		renderThread.join();
+
+		//shut down happens back on the main thread
+		manager->MakeCurrentContext(window);
+	}
+
+	void RenderThreadLoop()
+	{
+		manager->MakeCurrentContext(window);
+
+		while (true)
+		{
+			{
+				std::unique_lock lock(frameMutex);
+				frameSignal.wait(lock, [this]() { return frameSlots.HasNewFrame() || !isRenderThreadRunning; });
+				if (!isRenderThreadRunning)
+				{
+					break;
+				}
+			}
+
+			RenderFrame();
+		}
+
+		renderCommands.Execute();
+		ReleaseContext();
+	}
+
+	static void ReleaseContext()
+	{
+#if defined(TW_WINDOWS)
+		wglMakeCurrent(nullptr, nullptr);
+#elif defined(TW_LINUX)
+		glXMakeCurrent(glXGetCurrentDisplay(), None, nullptr);
+#endif
 	}
 
 	virtual void Draw()
 	{
 		PreDraw();
 
-		glBindVertexArray(defaultVertexBuffer.vertexArrayHandle);
-		glUseProgram(defProgram.handle);
+		glState_t::Get().BindVertexArray(defaultVertexBuffer.vertexArrayHandle);
+		glState_t::Get().UseProgram(defProgram.handle);
 		glDrawArrays(GL_TRIANGLES, 0, 6);
 
 		PostDraw();
@@ -227,10 +477,24 @@ protected:
 		{
 			ImGui::SetCurrentContext(windowContextMap[window]);
 
-			ImGui::Text("FPS %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, 1.0f / clock.GetDeltaTime());
-			ImGui::Text("Total running time %.5f", clock.GetTotalTime());
+			ImGui::Text("FPS %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, 1.0f / renderState.deltaTime);
+			ImGui::Text("Total running time %.5f", renderState.totalTime);
 			ImGui::Text("Mouse coordinates: \t X: %.0f \t Y: %.0f", io.MousePos.x, io.MousePos.y);
 			ImGui::Text("Window size: \t Width: %i \t Height: %i", window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+			ImGui::Text("Streaming textures: %zu \t Uploaded: %zu KB", textureStreamer_t::Get().GetNumPending(), textureStreamer_t::Get().GetBytesLastFrame() / 1024);
+			ImGui::Text("GL state calls: %u \t Skipped: %u", glState_t::Get().GetIssuedLastFrame(), glState_t::Get().GetSkippedLastFrame());
+
+			//glFinish, glGet*, blocking query results and fence waits, by call site
+			ImGui::Checkbox("Track stalls", &stallDetector_t::Get().isEnabled);
+			if (stallDetector_t::Get().isEnabled)
+			{
+				ImGui::Text("Stalls: %u calls \t %.3f ms", stallDetector_t::Get().GetLastFrameCalls(), stallDetector_t::Get().GetLastFrameMs());
+				for (const auto& site : stallDetector_t::Get().GetLastFrame())
+				{
+					ImGui::BulletText("%s \t %s:%i \t x%u \t %.3f ms", site.name, site.GetFileName(), site.line, site.numCalls, (double)site.timeNS / 1e6);
+				}
+			}
+			ImGui::Text("Texture cache: %zu entries \t Hits: %zu \t Misses: %zu", textureCache_t::Get().GetNumEntries(), textureCache_t::Get().GetNumHits(), textureCache_t::Get().GetNumMisses());
 
 			/*if(ImGui::Button("Toggle Fullscreen"))
 			{
@@ -246,32 +510,67 @@ protected:
 				manager->SetWindowSwapInterval(window, interval);
 			}
 
+			//the pacer runs on the main thread, so the cap and spin window get posted over rather than set here
 			static int frameRatePick = 0;
-			ImGui::ListBox("Frame rate cap", &frameRatePick, frameRateSettings.data(), (uint16_t)frameRateSettings.size());
-			switch (frameRatePick)
+			if (ImGui::ListBox("Frame rate cap", &frameRatePick, frameRateSettings.data(), (uint16_t)frameRateSettings.size()))
+			{
+				const int newFrameRate = (frameRatePick == 5) ? 144 : frameRatePick * 30;
+				DeferToSimThread([this, newFrameRate]() { lockedFrameRate = newFrameRate; });
+			}
+
+			ImGui::Text("Frame time %.3f ms \t Std dev %.3f ms \t Worst jitter %.3f ms", renderState.frameTimeMs, renderState.frameTimeStdDevMs, renderState.frameJitterMs);
+			float spinWindowMs = (float)renderState.spinWindow / 1e6f;
+			if (ImGui::SliderFloat("Spin window (ms)", &spinWindowMs, 0.0f, 4.0f, "%.2f"))
+			{
+				const int64_t spinWindow = (int64_t)(spinWindowMs * 1e6f);
+				DeferToSimThread([this, spinWindow]() { framePacer.spinWindow = spinWindow; });
+			}
+
+			//camera.resolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+			ImGui::Checkbox("wireframe", &wireframe);
+			ImGui::EndTabItem();
+		}
+		//ImGui::End();
+
+		DrawDebugLog();
+	}
+
+	//filters apply to messages from here on, the list only ever grows
+	virtual void DrawDebugLog()
+	{
+		if (ImGui::BeginTabItem("GL debug"))
+		{
+			debugLogger_t& logger = debugLogger_t::Get();
+			for (const GLenum severity : { GL_DEBUG_SEVERITY_HIGH, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_NOTIFICATION })
 			{
-			case 0: //none
-			case 1: //30
-			case 2: //60
-			case 3: //90
-			case 4: //120
+				bool isEnabled = logger.IsSeverityEnabled(severity);
+				if (ImGui::Checkbox(debugLogger_t::GetSeverityName(severity), &isEnabled))
 				{
-					lockedFrameRate = frameRatePick * 30;
-					break;
+					logger.SetSeverityEnabled(severity, isEnabled);
 				}
-			case 5: //144
+				ImGui::SameLine();
+			}
+			ImGui::NewLine();
+
+			for (GLenum source = GL_DEBUG_SOURCE_API; source <= GL_DEBUG_SOURCE_OTHER; source++)
+			{
+				bool isEnabled = logger.IsSourceEnabled(source);
+				if (ImGui::Checkbox(debugLogger_t::GetSourceName(source), &isEnabled))
 				{
-					lockedFrameRate = 144;
-					break;
+					logger.SetSourceEnabled(source, isEnabled);
 				}
-			default: {};
+				ImGui::SameLine();
 			}
+			ImGui::NewLine();
 
-			//camera.resolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
-			ImGui::Checkbox("wireframe", &wireframe);
+			ImGui::Text("Dropped: %llu", (unsigned long long)logger.GetNumDropped());
+			for (const auto& message : logger.GetMessages())
+			{
+				ImGui::TextWrapped("[%s] %s %s ID %u x%llu: %s", debugLogger_t::GetSeverityName(message.severity), debugLogger_t::GetSourceName(message.source),
+					debugLogger_t::GetTypeName(message.type), message.id, (unsigned long long)message.count, message.text.c_str());
+			}
 			ImGui::EndTabItem();
 		}
-		//ImGui::End();
 	}
 
 	virtual void DrawCameraStats()
@@ -279,58 +578,53 @@ protected:
 		//set up the view matrix
 		ImGui::Begin("camera", &isGUIActive);// , ImVec2(0, 0));
 
-		ImGui::Combo("projection type", (int*)&camera.currentProjectionType, "perspective\0orthographic");  // NOLINT(performance-no-int-to-ptr)
+		//edits go into the render copy and the settings that matter get posted to the main thread camera
+		bool changed = false;
+
+		changed |= ImGui::Combo("projection type", (int*)&renderCamera.currentProjectionType, "perspective\0orthographic");  // NOLINT(performance-no-int-to-ptr)
 
-		if (camera.currentProjectionType == camera_t::projection_e::orthographic)
+		if (renderCamera.currentProjectionType == camera_t::projection_e::orthographic)
 		{
-			ImGui::DragFloat("near plane", &camera.nearPlane);
-			ImGui::DragFloat("far plane", &camera.farPlane);
-			ImGui::SliderFloat("Field of view", &camera.fieldOfView, 0, 90, "%.10f");
+			changed |= ImGui::DragFloat("near plane", &renderCamera.nearPlane);
+			changed |= ImGui::DragFloat("far plane", &renderCamera.farPlane);
+			changed |= ImGui::SliderFloat("Field of view", &renderCamera.fieldOfView, 0, 90, "%.10f");
 		}
 
 		else
 		{
-			ImGui::InputFloat("camera speed", &camera.speed, 0.f);
-			ImGui::InputFloat("x sensitivity", &camera.xSensitivity, 0.f);
-			ImGui::InputFloat("y sensitivity", &camera.ySensitivity, 0.f);
+			changed |= ImGui::InputFloat("camera speed", &renderCamera.speed, 0.f);
+			changed |= ImGui::InputFloat("x sensitivity", &renderCamera.xSensitivity, 0.f);
+			changed |= ImGui::InputFloat("y sensitivity", &renderCamera.ySensitivity, 0.f);
 		}
 
+		//read only. the view is rebuilt from the main thread's camera every frame, so edits here would never stick
 		if (ImGui::TreeNode("view matrix"))
 		{
-			if (ImGui::TreeNode("right"))
+			const char* rowNames[] = { "right", "up", "forward", "position" };
+			for (int row = 0; row < 4; row++)
 			{
-				//ImGui::Columns(2);
-				//ImGui::ListBox("blarg", 0, )
-				//ImGui::Text("blarg");
-				//ImGui::SameLine();
-				//ImGui::NextColumn();
-				ImGui::DragFloat4("##", (float*)&camera.view[0], 0.1f, -100.0f, 100.0f);
-				//ImGui::Columns(1);
-				ImGui::TreePop();
-			}
-
-			if (ImGui::TreeNode("up"))
-			{
-				ImGui::DragFloat4("##", (float*)&camera.view[1], 0.1f, -100.0f, 100.0f);
-				ImGui::TreePop();
-			}
-
-			if (ImGui::TreeNode("forward"))
-			{
-				ImGui::DragFloat4("##", (float*)&camera.view[2], 0.1f, -100.0f, 100.0f);
-				ImGui::TreePop();
-			}
-
-			if (ImGui::TreeNode("position"))
-			{
-				ImGui::DragFloat4("##", (float*)&camera.view[3], 0.1f, -100.0f, 100.0f);
-				ImGui::TreePop();
+				const glm::vec4& value = renderCamera.view[row];
+				ImGui::Text("%-8s %8.3f %8.3f %8.3f %8.3f", rowNames[row], value.x, value.y, value.z, value.w);
 			}
 			ImGui::TreePop();
-
 		}
 		ImGui::End();
 
+		if (changed)
+		{
+			const camera_t edited = renderCamera;
+			DeferToSimThread([this, edited]()
+			{
+				camera.currentProjectionType = edited.currentProjectionType;
+				camera.nearPlane = edited.nearPlane;
+				camera.farPlane = edited.farPlane;
+				camera.fieldOfView = edited.fieldOfView;
+				camera.speed = edited.speed;
+				camera.xSensitivity = edited.xSensitivity;
+				camera.ySensitivity = edited.ySensitivity;
+			});
+		}
+
 		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
 		//UpdateBuffer(d, defaultUniform->bufferHandle, sizeof(defaultUniform), gl_uniform_buffer, gl_dynamic_draw);
 	}
@@ -340,11 +634,17 @@ protected:
 		ImGUINewFrame(window);
 
 		ImGui::DockSpace(ImGui::GetID(defaultDockName.c_str()), ImVec2(0.0f, 0.0f), ImGuiDockNodeFlags_NoResize);
-		ImGuiID dockspace_id = ImGui::GetID(defaultDockName.c_str());
-		//ImGui::DockBuilderRemoveNode(dockspace_id, dockspace_id | ImGuiDockNodeFlags_DockSpace);
-		ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace);
-		ImGui::DockBuilderSplitNode(dockspace_id, ImGuiDir_Left, 0.2f, &left_node, &central_node);
-		ImGui::DockBuilderFinish(dockspace_id);
+
+		//the layout never changes so it only needs building the once
+		if (!isDockBuilt)
+		{
+			ImGuiID dockspace_id = ImGui::GetID(defaultDockName.c_str());
+			//ImGui::DockBuilderRemoveNode(dockspace_id, dockspace_id | ImGuiDockNodeFlags_DockSpace);
+			ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace);
+			ImGui::DockBuilderSplitNode(dockspace_id, ImGuiDir_Left, 0.2f, &left_node, &central_node);
+			ImGui::DockBuilderFinish(dockspace_id);
+			isDockBuilt = true;
+		}
 
 		ImGui::SetNextWindowDockID(left_node, ImGuiCond_Once);
 		ImGui::Begin(window->GetSettings().name.c_str(), &isGUIActive, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize);
@@ -364,6 +664,11 @@ protected:
 
 	virtual void DrawGUI(tWindow* window)
 	{
+		if (isBenchmark)
+		{
+			return;
+		}
+
 		BeginGUI(window);
 		const ImGuiIO io = ImGui::GetIO();
 		BuildGUI(window, io);
@@ -383,7 +688,7 @@ protected:
 	virtual void InitializeUniforms()
 	{
 		defaultPayload.data = defaultUniformBuffer(this->camera);
-		glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		defaultPayload.data.resolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		defaultPayload.data.projection = glm::ortho(0.0f, (GLfloat)window->GetSettings().resolution.width, (GLfloat)window->GetSettings().resolution.height, 0.0f, 0.01f, 10.0f);
 
@@ -404,7 +709,7 @@ protected:
 		{
 			dimensions = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		}
-		glViewport(defaultViewportOrigin.x, defaultViewportOrigin.y, dimensions.x, dimensions.y);
+		glState_t::Get().Viewport(defaultViewportOrigin.x, defaultViewportOrigin.y, dimensions.x, dimensions.y);
 		
 		defaultPayload.data.resolution = glm::ivec2(dimensions.x, dimensions.y);
 		defaultPayload.data.projection = glm::ortho(0.0f, (GLfloat)dimensions.x, (GLfloat)dimensions.y, 0.0f, defaultNearPlane, defaultFarPlane);
@@ -412,42 +717,48 @@ protected:
 		UpdateBuffer(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
 	}
 
+	//the event handlers run on the main thread. imgui and GL both belong to the render thread so they get posted over
 	virtual void HandleMouseClick(const tWindow* window, const mouseButton_e button, const buttonState_e state)
 	{
-		ImGuiIO& io = ImGui::GetIO();
-
-		switch (button)
+		DeferToRenderThread([button, state]()
 		{
-			case mouseButton_e::left: state == buttonState_e::down ? io.MouseDown[0] = true : io.MouseDown[0] = false; break;
-			case mouseButton_e::right: state == buttonState_e::down ? io.MouseDown[1] = true : io.MouseDown[1] = false; break;
-			case mouseButton_e::middle: state == buttonState_e::down ? io.MouseDown[2] = true : io.MouseDown[2] = false; break;
-			default: break;;
-		}
+			ImGuiIO& io = ImGui::GetIO();
+
+			switch (button)
+			{
+				case mouseButton_e::left: state == buttonState_e::down ? io.MouseDown[0] = true : io.MouseDown[0] = false; break;
+				case mouseButton_e::right: state == buttonState_e::down ? io.MouseDown[1] = true : io.MouseDown[1] = false; break;
+				case mouseButton_e::middle: state == buttonState_e::down ? io.MouseDown[2] = true : io.MouseDown[2] = false; break;
+				default: break;;
+			}
+		});
 	}
 
 	virtual void HandleWindowResize(const tWindow* window, const vec2_t<uint16_t>& dimensions)
 	{
-		Resize(window, glm::vec2(dimensions.x, dimensions.y));
+		const glm::ivec2 newSize = glm::ivec2(dimensions.x, dimensions.y);
+		DeferToRenderThread([this, window, newSize]() { Resize(window, newSize); });
 	}
 
 	virtual void HandleMaximize(const tWindow* window)
 	{
 		//thrown in new window size
-		Resize(window, glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height));
+		const glm::ivec2 newSize = glm::ivec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		DeferToRenderThread([this, window, newSize]() { Resize(window, newSize); });
 	}
 
 	virtual void HandleMouseMotion(const tWindow* window, const vec2_t<int16_t>& windowPosition, const vec2_t<int16_t>& screenPosition)
 	{
-		defaultPayload.data.mousePosition = glm::vec2(windowPosition.x, windowPosition.y);
-		UpdateBuffer(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
-		ImGuiIO& io = ImGui::GetIO();
-		io.MousePos = ImVec2((float)windowPosition.x, (float)windowPosition.y); //why screen co-ordinates?
+		//goes out with the next snapshot
+		mousePosition = glm::vec2(windowPosition.x, windowPosition.y);
+		const ImVec2 imguiPosition = ImVec2((float)windowPosition.x, (float)windowPosition.y); //why screen co-ordinates?
+		DeferToRenderThread([imguiPosition]() { ImGui::GetIO().MousePos = imguiPosition; });
 	}
 
 	virtual void HandleMouseWheel(const tWindow* window, const mouseScroll_e scroll)
 	{
-		ImGuiIO& io = ImGui::GetIO();
-		io.MouseWheel += (float)((scroll == mouseScroll_e::down) ? -1 : 1);
+		const float wheel = (float)((scroll == mouseScroll_e::down) ? -1 : 1);
+		DeferToRenderThread([wheel]() { ImGui::GetIO().MouseWheel += wheel; });
 	}
 
 	static ImGuiKey MapToImGuiKey(const int16_t& key)
@@ -476,10 +787,10 @@ protected:
 
 	virtual void HandleKey(const tWindow* window, const int16_t& key, const keyState_e& keyState)
 	{
-		ImGuiIO& io = ImGui::GetIO();
 		ImGuiKey imguiKey = MapToImGuiKey(key);
 		if (imguiKey != ImGuiKey_None) {
-			io.AddKeyEvent(imguiKey, keyState == keyState_e::down);
+			const bool isDown = keyState == keyState_e::down;
+			DeferToRenderThread([imguiKey, isDown]() { ImGui::GetIO().AddKeyEvent(imguiKey, isDown); });
 		}
 	}
 
@@ -525,59 +836,56 @@ protected:
 		imGUIVBOHandle = 0;
 		imGUIVAOHandle = 0;
 		imGUIIBOHandle = 0;
+		imGUIVertexPtr = nullptr;
+		imGUIIndexPtr = nullptr;
+		imGUIVertexCapacity = 0;
+		imGUIIndexCapacity = 0;
 		imGUIFontTexture = 0;
 
 		ImGui::SetCurrentContext(windowContextMap[window]);
 	}
 
+	//known state contract: the scene hands over with blend, cull and scissor off and depth testing matching
+	//depthTestEnabled. we set what the GUI needs and put that back afterwards, no glGet round trips
 	virtual void HandleImGUIRender(tWindow* window)
 	{
 		ImDrawData* drawData = ImGui::GetDrawData();
+		if (drawData->TotalVtxCount == 0)
+		{
+			return;
+		}
 
 		ImGuiIO& io = ImGui::GetIO();
 
 		drawData->ScaleClipRects(io.DisplayFramebufferScale);
 
-		GLint lastProgram;
-		GLint lastTexture;
-		GLint lastArrayBuffer;
-		GLint lastElementArrayBuffer;
-		GLint lastVertexArray;
-		GLint lastBlendSrc;
-		GLint lastBlendDst;
-		GLint lastBlendEquationRGB;
-		GLint lastBlendEquationAlpha;
-		GLint lastViewport[4];
-
-		glGetIntegerv(GL_CURRENT_PROGRAM, &lastProgram);
-		glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
-		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &lastArrayBuffer);
-		glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &lastElementArrayBuffer);
-		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &lastVertexArray);
-		glGetIntegerv(GL_BLEND_SRC, &lastBlendSrc);
-		glGetIntegerv(GL_BLEND_DST, &lastBlendDst);
-		glGetIntegerv(GL_BLEND_EQUATION_RGB, &lastBlendEquationRGB);
-		glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &lastBlendEquationAlpha);
-		glGetIntegerv(GL_VIEWPORT, lastViewport);
-
-		GLboolean lastEnableBlend = glIsEnabled(GL_BLEND);
-		GLboolean lastEnableCullFace = glIsEnabled(GL_CULL_FACE);
-		GLboolean lastEnableDepthTest = glIsEnabled(GL_DEPTH_TEST);
-		GLboolean lastEnableScissorTest = glIsEnabled(GL_SCISSOR_TEST);
-
-		glEnable(GL_BLEND);
-		glBlendEquation(GL_FUNC_ADD);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glDisable(GL_CULL_FACE);
-		glDisable(GL_DEPTH_TEST);
-		glEnable(GL_SCISSOR_TEST);
-		glActiveTexture(GL_TEXTURE0);
-
-		const glm::vec2 resolution = glm::vec2(window->GetSettings().resolution.x, window->GetSettings().resolution.y);
-		glViewport(0, 0, (GLsizei)(io.DisplaySize.x * io.DisplayFramebufferScale.x),
+		ReserveImGUIBuffers((size_t)drawData->TotalVtxCount, (size_t)drawData->TotalIdxCount);
+
+		//every list goes into this frame's region of the ring. bufferFrames_t::EndFrame makes sure the GPU is done with it
+		const size_t frame = bufferFrames_t::GetCurrentFrame();
+		const size_t vertexRegion = frame * imGUIVertexCapacity;
+		const size_t indexRegion = frame * imGUIIndexCapacity;
+		size_t numVertices = 0;
+		size_t numIndices = 0;
+		for (int numCommandLists = 0; numCommandLists < drawData->CmdListsCount; numCommandLists++)
+		{
+			const ImDrawList* commandList = drawData->CmdLists[numCommandLists];
+			memcpy(imGUIVertexPtr + vertexRegion + numVertices, commandList->VtxBuffer.Data, commandList->VtxBuffer.size() * sizeof(ImDrawVert));
+			memcpy(imGUIIndexPtr + indexRegion + numIndices, commandList->IdxBuffer.Data, commandList->IdxBuffer.size() * sizeof(ImDrawIdx));
+			numVertices += commandList->VtxBuffer.size();
+			numIndices += commandList->IdxBuffer.size();
+		}
+
+		glState_t& state = glState_t::Get();
+		state.SetEnabled(GL_BLEND, true);
+		state.BlendEquation(GL_FUNC_ADD);
+		state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		state.SetEnabled(GL_DEPTH_TEST, false);
+		state.SetEnabled(GL_SCISSOR_TEST, true);
+
+		state.Viewport(0, 0, (GLsizei)(io.DisplaySize.x * io.DisplayFramebufferScale.x),
                  (GLsizei)(io.DisplaySize.y * io.DisplayFramebufferScale.y));
 
-		glm::mat4 proj = glm::ortho(-(resolution.x / 2), resolution.x / 2, resolution.y / 2, -(resolution.y / 2), -1.0f, 10.f);
 		const float orthoProjection[4][4] =
 		{
 			{ 2.0f / (float)window->GetSettings().resolution.width, 0.0f, 0.0f, 0.0f },
@@ -585,22 +893,17 @@ protected:
 			{ 0.0f, 0.0f, -1.0f, 0.0f },
 			{ -1.0f, 1.0f, 0.0f, 1.0f }
 		};
-		//glm::mat4 testOrtho = glm::perspective(45.0f, )
-		glUseProgram(imGUIShaderhandle);
+		state.UseProgram(imGUIShaderhandle);
 		glUniform1i(imGUITexAttribLocation, 0);
 		glUniformMatrix4fv(imGUIProjMatrixAttribLocation, 1, GL_FALSE, &orthoProjection[0][0]);
-		glBindVertexArray(imGUIVAOHandle);
+		state.BindVertexArray(imGUIVAOHandle);
+		glVertexArrayVertexBuffer(imGUIVAOHandle, 0, imGUIVBOHandle, (GLintptr)(vertexRegion * sizeof(ImDrawVert)), sizeof(ImDrawVert));
 
+		GLint listVertexStart = 0;
+		size_t listIndexStart = indexRegion;
 		for (int numCommandLists = 0; numCommandLists < drawData->CmdListsCount; numCommandLists++)
 		{
 			const ImDrawList* commandList = drawData->CmdLists[numCommandLists];
-			const ImDrawIdx* indexBufferOffset = nullptr;
-
-			glBindBuffer(GL_ARRAY_BUFFER, imGUIVBOHandle);
-			glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)commandList->VtxBuffer.size() * sizeof(ImDrawVert), (GLvoid*)&commandList->VtxBuffer.front(), GL_STREAM_DRAW);
-
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, imGUIIBOHandle);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)commandList->IdxBuffer.size() * sizeof(ImDrawIdx), (GLvoid*)&commandList->IdxBuffer.front(), GL_STREAM_DRAW);
 
 			for (const ImDrawCmd* drawCommand = commandList->CmdBuffer.begin(); drawCommand != commandList->CmdBuffer.end(); drawCommand++)
 			{
@@ -611,28 +914,59 @@ protected:
 
 				else
 				{
-					glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)drawCommand->GetTexID());
-					glScissor(drawCommand->ClipRect.x, window->GetSettings().resolution.height - drawCommand->ClipRect.w, drawCommand->ClipRect.z - drawCommand->ClipRect.x, drawCommand->ClipRect.w - drawCommand->ClipRect.y);
-					glDrawElements(GL_TRIANGLES, (GLsizei)drawCommand->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, indexBufferOffset);
+					state.BindTextureUnit(0, (GLuint)(intptr_t)drawCommand->GetTexID());
+					state.Scissor(drawCommand->ClipRect.x, window->GetSettings().resolution.height - drawCommand->ClipRect.w, drawCommand->ClipRect.z - drawCommand->ClipRect.x, drawCommand->ClipRect.w - drawCommand->ClipRect.y);
+					glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)drawCommand->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+						(void*)((listIndexStart + drawCommand->IdxOffset) * sizeof(ImDrawIdx)), listVertexStart + (GLint)drawCommand->VtxOffset);
 				}
+			}
 
-				indexBufferOffset += drawCommand->ElemCount;
+			listVertexStart += commandList->VtxBuffer.size();
+			listIndexStart += commandList->IdxBuffer.size();
+		}
+
+		//back to the known state
+		state.SetEnabled(GL_BLEND, false);
+		state.SetEnabled(GL_SCISSOR_TEST, false);
+		state.SetEnabled(GL_DEPTH_TEST, depthTestEnabled);
+	}
+
+	//one persistently mapped vertex and index buffer, split into a region per frame in flight.
+	//only reallocates when a frame needs more than we have, GL keeps the old buffers alive for frames still using them
+	void ReserveImGUIBuffers(const size_t& numVertices, const size_t& numIndices)
+	{
+		if (numVertices <= imGUIVertexCapacity && numIndices <= imGUIIndexCapacity)
+		{
+			return;
+		}
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		if (numVertices > imGUIVertexCapacity)
+		{
+			if (imGUIVBOHandle != 0)
+			{
+				glDeleteBuffers(1, &imGUIVBOHandle);
 			}
+			imGUIVertexCapacity = std::max<size_t>(numVertices * 2, 8192);
+			const GLsizeiptr size = (GLsizeiptr)(imGUIVertexCapacity * sizeof(ImDrawVert) * bufferFrames_t::numFrames);
+			glCreateBuffers(1, &imGUIVBOHandle);
+			glNamedBufferStorage(imGUIVBOHandle, size, nullptr, flags);
+			imGUIVertexPtr = (ImDrawVert*)glMapNamedBufferRange(imGUIVBOHandle, 0, size, flags);
 		}
 
-		glUseProgram(lastProgram);
-		//glActiveTexture(lastActiveTexture);
-		glBindTexture(GL_TEXTURE_2D, lastTexture);
-		glBindVertexArray(lastVertexArray);
-		glBindBuffer(GL_ARRAY_BUFFER, lastArrayBuffer);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lastElementArrayBuffer);
-		glBlendEquationSeparate(lastBlendEquationRGB, lastBlendEquationAlpha);
-		glBlendFunc(lastBlendSrc, lastBlendDst);
-		lastEnableBlend ? glEnable(GL_BLEND) : glDisable(GL_BLEND);
-		lastEnableCullFace ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
-		lastEnableDepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
-		lastEnableScissorTest ? glEnable(GL_SCISSOR_TEST) : glDisable(GL_SCISSOR_TEST);
-		glViewport(lastViewport[0], lastViewport[1], (GLsizei)lastViewport[2], (GLsizei)lastViewport[3]);
+		if (numIndices > imGUIIndexCapacity)
+		{
+			if (imGUIIBOHandle != 0)
+			{
+				glDeleteBuffers(1, &imGUIIBOHandle);
+			}
+			imGUIIndexCapacity = std::max<size_t>(numIndices * 2, 16384);
+			const GLsizeiptr size = (GLsizeiptr)(imGUIIndexCapacity * sizeof(ImDrawIdx) * bufferFrames_t::numFrames);
+			glCreateBuffers(1, &imGUIIBOHandle);
+			glNamedBufferStorage(imGUIIBOHandle, size, nullptr, flags);
+			imGUIIndexPtr = (ImDrawIdx*)glMapNamedBufferRange(imGUIIBOHandle, 0, size, flags);
+			glVertexArrayElementBuffer(imGUIVAOHandle, imGUIIBOHandle);
+		}
 	}
 
 	virtual void ImGUICreateFontsTexture()
@@ -642,18 +976,14 @@ protected:
 		int width, height;
 		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
 
-		GLint lastTexture;
-		glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
-		glGenTextures(1, &imGUIFontTexture);
-		glBindTexture(GL_TEXTURE_2D, imGUIFontTexture);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		glCreateTextures(GL_TEXTURE_2D, 1, &imGUIFontTexture);
+		glTextureParameteri(imGUIFontTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(imGUIFontTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureStorage2D(imGUIFontTexture, 1, GL_RGBA8, width, height);
+		glTextureSubImage2D(imGUIFontTexture, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
 		//store the texture handle
 		io.Fonts->TexID = static_cast<ImTextureID>(imGUIFontTexture);
-
-		glBindTexture(GL_TEXTURE_2D, lastTexture);
 	}
 
 	virtual void ImGUINewFrame(const tWindow* drawWindow)
@@ -666,7 +996,7 @@ protected:
 		ImGuiIO& io = ImGui::GetIO();
 		io.DisplaySize = ImVec2((float)drawWindow->GetSettings().resolution.width, (float)drawWindow->GetSettings().resolution.height);
 		io.DisplayFramebufferScale = ImVec2(1, 1);
-		io.DeltaTime = (float)clock.GetDeltaTime();
+		io.DeltaTime = std::max((float)renderState.deltaTime, 1e-6f); //imgui asserts on a zero delta
 
 		auto it = windowContextMap.find(window);
 		if (it != windowContextMap.end())
@@ -679,11 +1009,6 @@ protected:
 
 	virtual void ImGUICreateDeviceObjects()
 	{
-		GLint lastTexture, lastArrayBuffer, LastVertexArray;
-		glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
-		glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &lastArrayBuffer);
-		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &LastVertexArray);
-
 		const char *vertex_shader =
 			"#version 330\n"
 			"uniform mat4 ProjMtx;\n"
@@ -727,48 +1052,48 @@ protected:
 		imGUIUVAttribLocation = glGetAttribLocation(imGUIShaderhandle, "UV");
 		imGUIColorAttribLocation = glGetAttribLocation(imGUIShaderhandle, "Color");
 
-		glGenBuffers(1, &imGUIVBOHandle);
-		glGenBuffers(1, &imGUIIBOHandle);
-
-		glGenVertexArrays(1, &imGUIVAOHandle);
-		glBindVertexArray(imGUIVAOHandle);
-		glBindBuffer(GL_ARRAY_BUFFER, imGUIVBOHandle);
-		glEnableVertexAttribArray(imGUIPositionAttribLocation);
-		glEnableVertexAttribArray(imGUIUVAttribLocation);
-		glEnableVertexAttribArray(imGUIColorAttribLocation);
-
-#define OFFSETOF(TYPE, ELEMENT) ((size_t)&(((TYPE *)0)->ELEMENT))
-		glVertexAttribPointer(imGUIPositionAttribLocation, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos));
-		glVertexAttribPointer(imGUIUVAttribLocation, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv));
-		glVertexAttribPointer(imGUIColorAttribLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col));
-#undef OFFSETOF
+		//vertex and index buffers are made on demand by ReserveImGUIBuffers, the vertex buffer gets attached per frame
+		glCreateVertexArrays(1, &imGUIVAOHandle);
+		const std::tuple<GLint, GLint, GLenum, GLboolean, GLuint> attributes[] =
+		{
+			{ imGUIPositionAttribLocation, 2, GL_FLOAT, GL_FALSE, (GLuint)offsetof(ImDrawVert, pos) },
+			{ imGUIUVAttribLocation, 2, GL_FLOAT, GL_FALSE, (GLuint)offsetof(ImDrawVert, uv) },
+			{ imGUIColorAttribLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, (GLuint)offsetof(ImDrawVert, col) }
+		};
+		for (const auto& [location, numComponents, type, normalized, offset] : attributes)
+		{
+			glEnableVertexArrayAttrib(imGUIVAOHandle, location);
+			glVertexArrayAttribFormat(imGUIVAOHandle, location, numComponents, type, normalized, offset);
+			glVertexArrayAttribBinding(imGUIVAOHandle, location, 0);
+		}
 
 		ImGUICreateFontsTexture();
-
-		//restore GL state
-		glBindTexture(GL_TEXTURE_2D, lastTexture); //why do the values change?
-		glBindBuffer(GL_ARRAY_BUFFER, lastArrayBuffer);
-		glBindVertexArray(LastVertexArray);
 	}
 
 	virtual void ImGUIInvalidateDeviceObject()
 	{
 		if (imGUIVAOHandle)
 		{
+			glState_t::Get().OnVertexArrayDeleted(imGUIVAOHandle);
 			glDeleteVertexArrays(1, &imGUIVAOHandle);
 			imGUIVAOHandle = 0;
 		}
 
+		//deleting a mapped buffer unmaps it
 		if (imGUIVBOHandle)
 		{
 			glDeleteBuffers(1, &imGUIVBOHandle);
 			imGUIVBOHandle = 0;
+			imGUIVertexPtr = nullptr;
+			imGUIVertexCapacity = 0;
 		}
 
 		if (imGUIIBOHandle)
 		{
 			glDeleteBuffers(1, &imGUIIBOHandle);
 			imGUIIBOHandle = 0;
+			imGUIIndexPtr = nullptr;
+			imGUIIndexCapacity = 0;
 		}
 
 		glDetachShader(imGUIShaderhandle, imGUIVertexHandle);
@@ -784,78 +1109,13 @@ protected:
 
 		if (imGUIFontTexture)
 		{
+			glState_t::Get().OnTextureDeleted(imGUIFontTexture);
 			glDeleteTextures(1, &imGUIFontTexture);
 			ImGui::GetIO().Fonts->TexID = nullptr;
 			imGUIFontTexture = 0;
 		}
 	}
 
-	static void APIENTRY OpenGLDebugCallback(GLenum source,
-		GLenum type,
-		GLuint id,
-		GLenum severity,
-		GLsizei length,
-		const char* message,
-		const void* userParam)
-	{
-		if (severity != GL_DEBUG_SEVERITY_LOW &&
-			severity != GL_DEBUG_SEVERITY_MEDIUM &&
-			severity != GL_DEBUG_SEVERITY_HIGH)
-		{
-			//we can skip these for the time being
-			return;
-		}
-
-		printf("---------------------opengl-callback-start------------\n");
-		//print debug type
-		printf("type: ");
-		printf("%s\n", debugTypeLUT.at((int32_t)type).c_str());
-
-		printf("ID: %i\n", id);
-
-		//severity
-		printf("severity: ");
-		printf("%s\n", severityLUT.at((int32_t)severity).c_str());
-
-		//source
-		printf("Source: ");
-		printf("%s\n", sourceTypeLUT.at((int32_t)source).c_str());
-
-		printf("Message: \n");
-		printf("%s \n", message);
-
-		printf("---------------------opengl-callback-end--------------\n");
-	}
-};
-
-tsl::robin_map<int32_t, std::string> scene::debugTypeLUT =
-{
-	debugTypeEntry(GL_DEBUG_TYPE_ERROR, "error"),
-	debugTypeEntry(GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR, "deprecated behavior"),
-	debugTypeEntry(GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR, "undefined behavior"),
-	debugTypeEntry(GL_DEBUG_TYPE_PERFORMANCE, "performance"),
-	debugTypeEntry(GL_DEBUG_TYPE_PORTABILITY, "portability"),
-	debugTypeEntry(GL_DEBUG_TYPE_MARKER, "marker"),
-	debugTypeEntry(GL_DEBUG_TYPE_PUSH_GROUP, "push group"),
-	debugTypeEntry(GL_DEBUG_TYPE_POP_GROUP, "pop group"),
-	debugTypeEntry(GL_DEBUG_TYPE_OTHER, "other"),
-};
-
-tsl::robin_map<int32_t, std::string> scene::severityLUT =
-{
-	severityEntry(GL_DEBUG_SEVERITY_LOW, "low"),
-	severityEntry(GL_DEBUG_SEVERITY_MEDIUM, "medium"),
-	severityEntry(GL_DEBUG_SEVERITY_HIGH, "high"),
-};
-
-tsl::robin_map<int32_t, std::string> scene::sourceTypeLUT =
-{
-	sourceTypeEntry(GL_DEBUG_SOURCE_API, "API"),
-	sourceTypeEntry(GL_DEBUG_SOURCE_SHADER_COMPILER, "shader compiler"),
-	sourceTypeEntry(GL_DEBUG_SOURCE_WINDOW_SYSTEM, "window system"),
-	sourceTypeEntry(GL_DEBUG_SOURCE_THIRD_PARTY, "third party"),
-	sourceTypeEntry(GL_DEBUG_SOURCE_APPLICATION, "application"),
-	sourceTypeEntry(GL_DEBUG_SOURCE_OTHER, "other"),
 };
 
 tsl::robin_map<int32_t, ImGuiKey> scene::keyMapLUT =
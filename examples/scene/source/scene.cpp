@@ -1,7 +1,8 @@
 #include <scene.h>
-int main()
+int main(int argc, char* argv[])
 {
 	scene exampleScene;
+	exampleScene.ParseArguments(argc, argv);
 	exampleScene.Initialize();
 	exampleScene.Run();
 	return 0;
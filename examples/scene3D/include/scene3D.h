@@ -52,18 +52,30 @@ public:
 	{
 		scene::Initialize();
 		testModel.loadModel();
+		geometryArena.AddModel(testModel);
+		geometryArena.Upload();
 
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc(GL_LEQUAL);
+		glState_t::Get().SetEnabled(GL_DEPTH_TEST, true);
+		glState_t::Get().DepthFunc(GL_LEQUAL);
+		depthTestEnabled = true;
 
 		accum = 0.0f;
 		accumReturn = 0.0f;
 		accumMult = 0.0f;
 	}
 
+	//the arena's resident handles have to go before the cache deletes the textures behind them
+	void ShutDown(tWindow* window) override
+	{
+		geometryArena.ShutDown();
+		testModel.UnloadTextures();
+		scene::ShutDown(window);
+	}
+
 protected:
 
 	model_t testModel;
+	geometryArena_t geometryArena;
 	bufferHandler_t<baseMaterialSettings_t>	materialBuffer;
 
 	unsigned int OGLProgram{};
@@ -74,53 +86,49 @@ protected:
 
 	void Draw() override
 	{
-		for (const auto& iter : testModel.meshes)
-		{
-			glBindVertexArray(iter.vertexArrayHandle);
-			glUseProgram(defProgram.handle);
-
-			glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		testModel.SelectLODs(renderCamera.view, renderCamera.projection, glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height));
+		geometryArena.ApplyLODs(testModel);
 
-			if (wireframe)
-			{
-				glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-			}
+		glState_t::Get().UseProgram(defProgram.handle);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 
-			glDrawElements(GL_TRIANGLES, iter.indices.size(), GL_UNSIGNED_INT, 0);
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		if (wireframe)
+		{
+			glState_t::Get().PolygonMode(GL_LINE);
 		}
 
+		geometryArena.Draw(defProgram.handle);
+		glState_t::Get().PolygonMode(GL_FILL);
+
 		DrawGUI(window);
 
 		manager->SwapDrawBuffers(window);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
-	void Update() override
+	void UpdateUniforms() override
 	{
-		//this keeps resetting the values
-		manager->PollForEvents();
-		camera.Update();
-		clock.UpdateClockAdaptive();
-
-		defaultPayload.data.deltaTime = (float)clock.GetDeltaTime();
-		defaultPayload.data.totalTime = (float)clock.GetTotalTime();
-		defaultPayload.data.framesPerSec = (float)(1.0 / clock.GetDeltaTime());
-		defaultPayload.data.totalFrames++;
-
-		defaultPayload.data.projection = camera.projection;
-		defaultPayload.data.view = camera.view;
-		if (camera.currentProjectionType == camera_t::projection_e::perspective)
+		defaultPayload.data.deltaTime = (float)renderState.deltaTime;
+		defaultPayload.data.totalTime = (float)renderState.totalTime;
+		defaultPayload.data.framesPerSec = (float)(1.0 / renderState.deltaTime);
+		defaultPayload.data.totalFrames = renderState.totalFrames;
+		defaultPayload.data.mousePosition = renderState.mousePosition;
+
+		defaultPayload.data.projection = renderCamera.projection;
+		defaultPayload.data.view = renderCamera.view;
+		if (renderCamera.currentProjectionType == camera_t::projection_e::perspective)
 		{
 			defaultPayload.data.translation = glm::identity<glm::mat4>();
 		}
 
 		else
 		{
-			defaultPayload.data.translation = camera.translation;
+			defaultPayload.data.translation = renderCamera.translation;
 		}
 
 		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+
+		textureStreamer_t::Get().Update();
 	}
 
 	void BuildGUI(tWindow* window, const ImGuiIO& io) override
@@ -134,17 +142,39 @@ protected:
 		//set up the view matrix
 		if (ImGui::BeginTabItem("Camera"))
 		{
-			ImGui::SliderFloat("near plane", &camera.nearPlane, defaultNearPlane, 1.0f, "%.3f", ImGuiSliderFlags_NoInput);
-			ImGui::SliderFloat("far plane", &camera.farPlane, 0, defaultFarPlane, "%.3f", ImGuiSliderFlags_NoInput);
-			ImGui::SliderFloat("Field of view", &camera.fieldOfView, 0, defaultFieldOfView, "%.3f", ImGuiSliderFlags_NoInput);
+			//the camera belongs to the main thread. edit the render copy and post the result over
+			bool changed = false;
+			changed |= ImGui::SliderFloat("near plane", &renderCamera.nearPlane, defaultNearPlane, 1.0f, "%.3f", ImGuiSliderFlags_NoInput);
+			changed |= ImGui::SliderFloat("far plane", &renderCamera.farPlane, 0, defaultFarPlane, "%.3f", ImGuiSliderFlags_NoInput);
+			changed |= ImGui::SliderFloat("Field of view", &renderCamera.fieldOfView, 0, defaultFieldOfView, "%.3f", ImGuiSliderFlags_NoInput);
+
+			changed |= ImGui::InputFloat("camera speed", &renderCamera.speed, 0.01f);
+			changed |= ImGui::InputFloat("x sensitivity", &renderCamera.xSensitivity, 0.f);
+			changed |= ImGui::InputFloat("y sensitivity", &renderCamera.ySensitivity, 0.f);
 
-			ImGui::InputFloat("camera speed", &camera.speed, 0.01f);
-			ImGui::InputFloat("x sensitivity", &camera.xSensitivity, 0.f);
-			ImGui::InputFloat("y sensitivity", &camera.ySensitivity, 0.f);
+			if (changed)
+			{
+				const camera_t edited = renderCamera;
+				DeferToSimThread([this, edited]()
+				{
+					camera.nearPlane = edited.nearPlane;
+					camera.farPlane = edited.farPlane;
+					camera.fieldOfView = edited.fieldOfView;
+					camera.speed = edited.speed;
+					camera.xSensitivity = edited.xSensitivity;
+					camera.ySensitivity = edited.ySensitivity;
+				});
+			}
+
+			ImGui::Text("local up %f %f %f %f", renderCamera.up.x, renderCamera.up.y, renderCamera.up.z, renderCamera.up.w);
+			ImGui::Text("local right %f %f %f %f", renderCamera.right.x, renderCamera.right.y, renderCamera.right.z, renderCamera.right.w);
+			ImGui::Text("local forward %f %f %f %f", renderCamera.forward.x, renderCamera.forward.y, renderCamera.forward.z, renderCamera.forward.w);
 
-			ImGui::Text("local up %f %f %f %f", camera.up.x, camera.up.y, camera.up.z, camera.up.w);
-			ImGui::Text("local right %f %f %f %f", camera.right.x, camera.right.y, camera.right.z, camera.right.w);
-			ImGui::Text("local forward %f %f %f %f", camera.forward.x, camera.forward.y, camera.forward.z, camera.forward.w);
+			ImGui::DragFloat("LOD threshold (px)", &testModel.lodPixelThreshold, 1.0f, 1.0f, 4096.0f);
+			for (const auto& lodChain : testModel.lodChains)
+			{
+				ImGui::Text("%s: LOD %zu of %zu", lodChain.name.c_str(), lodChain.currentLOD, lodChain.meshes.size());
+			}
 
 			ImGui::EndTabItem();
 		}
@@ -153,7 +183,7 @@ protected:
 	void InitializeUniforms() override
 	{
 		defaultPayload.data = defaultUniformBuffer(camera);
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
+		glState_t::Get().Viewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 
 		defaultPayload.data.resolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		defaultPayload.data.projection = camera.projection;
@@ -193,53 +223,57 @@ protected:
 		}
 	}
 
+	//the projection follows the camera over in the next snapshot, only the viewport and resolution are GL side
 	void HandleMaximize(const tWindow* window) override
 	{
-		glViewport(0, 0, window->GetSettings().resolution.width, window->GetSettings().resolution.height);
 		camera.resolution = glm::vec2(window->GetSettings().resolution.width, window->GetSettings().resolution.height);
-		defaultPayload.data.resolution = camera.resolution;
 		camera.UpdateProjection();
-		defaultPayload.data.projection = camera.projection;
 
-		//bind the uniform buffer and refill it
-		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+		const glm::vec2 resolution = camera.resolution;
+		DeferToRenderThread([this, resolution]()
+		{
+			glState_t::Get().Viewport(0, 0, (GLsizei)resolution.x, (GLsizei)resolution.y);
+			defaultPayload.data.resolution = resolution;
+		});
 	}
 
 	void HandleWindowResize(const tWindow* window, const vec2_t<uint16_t>& dimensions) override
 	{
-		glViewport(0, 0, dimensions.width, dimensions.height);
 		camera.resolution = glm::vec2(dimensions.width, dimensions.height);
-		defaultPayload.data.resolution = camera.resolution;
 		camera.UpdateProjection();
-		defaultPayload.data.projection = camera.projection;
-		defaultPayload.data.deltaTime = (float)clock.GetDeltaTime();
-		defaultPayload.data.totalTime = (float)clock.GetTotalTime();
-		defaultPayload.data.framesPerSec = (float)(1.0 / clock.GetDeltaTime());
 
-		defaultPayload.Update(GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW);
+		const glm::vec2 resolution = camera.resolution;
+		DeferToRenderThread([this, resolution]()
+		{
+			glState_t::Get().Viewport(0, 0, (GLsizei)resolution.x, (GLsizei)resolution.y);
+			defaultPayload.data.resolution = resolution;
+		});
 	}
 
 	void HandleKey(const tWindow* window, const int16_t& key, const keyState_e& state)	override
 	{
-		auto it = windowContextMap.find(const_cast<tWindow*>(window));
-		if (it != windowContextMap.end())
+		//imgui lives on the render thread, the camera moves stay here
+		DeferToRenderThread([this, window, key, state]()
 		{
-			ImGui::SetCurrentContext(it->second);
-		}
-		ImGuiIO& io = ImGui::GetIO();
-
+			auto it = windowContextMap.find(const_cast<tWindow*>(window));
+			if (it != windowContextMap.end())
+			{
+				ImGui::SetCurrentContext(it->second);
+			}
+			ImGuiIO& io = ImGui::GetIO();
 
-		if (state == keyState_e::down)
-		{
-			io.KeysData[key].Down = true;
-			io.AddInputCharacter(key);
-		}
+			if (state == keyState_e::down)
+			{
+				io.KeysData[key].Down = true;
+				io.AddInputCharacter(key);
+			}
 
-		else
+			else
+			{
+				io.KeysData[key].Down = false;
+			}
+		});
 
-		{
-			io.KeysData[key].Down = false;
-		}
 		float camSpeed = 0.0f;
 		if (key == TinyWindow::key_e::leftShift && state == keyState_e::down)
 		{
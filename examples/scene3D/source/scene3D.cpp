@@ -1,8 +1,9 @@
 #include "scene3D.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 	scene3D* exampleScene = new scene3D();
+	exampleScene->ParseArguments(argc, argv);
 	exampleScene->Initialize();
 	exampleScene->Run();
 
@@ -0,0 +1,354 @@
+#pragma once
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+//one file holding every small asset a project reads at startup, so a cold start is one open and one mmap instead of
+//a few hundred opens and reads. layout: header, table of contents sorted by path hash, path strings, then the entries,
+//each starting on a 4KB boundary so they line up with pages. written by tools/assetPacker, paths are relative to assets/
+struct assetPackHeader_t
+{
+	static constexpr uint32_t	currentMagic = 0x4B415041; //"APAK"
+	static constexpr uint32_t	currentVersion = 1;
+	static constexpr uint64_t	alignment = 4096;
+
+	uint32_t	magic = currentMagic;
+	uint32_t	version = currentVersion;
+	uint32_t	numEntries = 0;
+	uint32_t	pathBytes = 0;
+};
+
+struct assetPackEntry_t
+{
+	uint64_t	hash;
+	uint64_t	offset;
+	uint64_t	size;
+	uint32_t	pathOffset;
+	uint32_t	pathSize;
+};
+
+//FNV-1a over the path with forward slashes
+static constexpr uint64_t HashAssetPath(const std::string_view& path)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (const char& character : path)
+	{
+		hash ^= (uint8_t)(character == '\\' ? '/' : character);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+//read-only view of a pack. the whole file is mapped once and entries are handed out as spans straight into it
+class assetPack_t
+{
+public:
+
+	assetPack_t()
+	{
+		mapped = nullptr;
+		mappedSize = 0;
+		header = nullptr;
+		entries = nullptr;
+		paths = nullptr;
+#if defined(_WIN32)
+		fileHandle = INVALID_HANDLE_VALUE;
+		mappingHandle = nullptr;
+#endif
+	}
+
+	~assetPack_t()
+	{
+		Close();
+	}
+
+	assetPack_t(const assetPack_t&) = delete;
+	assetPack_t& operator=(const assetPack_t&) = delete;
+
+	bool Open(const std::string& packPath)
+	{
+		Close();
+		if (!Map(packPath))
+		{
+			return false;
+		}
+
+		header = (const assetPackHeader_t*)mapped;
+		const size_t tocSize = sizeof(assetPackHeader_t) + (mappedSize >= sizeof(assetPackHeader_t) ? header->numEntries * sizeof(assetPackEntry_t) : 0);
+		if (mappedSize < sizeof(assetPackHeader_t) || header->magic != assetPackHeader_t::currentMagic ||
+			header->version != assetPackHeader_t::currentVersion || mappedSize < tocSize + header->pathBytes)
+		{
+			printf("not a usable asset pack: %s \n", packPath.c_str());
+			Close();
+			return false;
+		}
+
+		entries = (const assetPackEntry_t*)(mapped + sizeof(assetPackHeader_t));
+		paths = (const char*)(mapped + tocSize);
+		return true;
+	}
+
+	void Close()
+	{
+		if (mapped != nullptr)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(mapped);
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+			mappingHandle = nullptr;
+#else
+			munmap((void*)mapped, mappedSize);
+#endif
+		}
+
+		mapped = nullptr;
+		mappedSize = 0;
+		header = nullptr;
+		entries = nullptr;
+		paths = nullptr;
+	}
+
+	bool IsOpen() const
+	{
+		return header != nullptr;
+	}
+
+	//binary search on the hash, then the path itself in case two of them collide. empty if it isn't in the pack
+	std::span<const uint8_t> Find(const std::string_view& path) const
+	{
+		if (!IsOpen())
+		{
+			return {};
+		}
+
+		const uint64_t hash = HashAssetPath(path);
+		const assetPackEntry_t* end = entries + header->numEntries;
+		for (const assetPackEntry_t* entry = std::lower_bound(entries, end, hash, [](const assetPackEntry_t& lhs, const uint64_t& rhs) { return lhs.hash < rhs; });
+			entry != end && entry->hash == hash; entry++)
+		{
+			if (IsSamePath(std::string_view(paths + entry->pathOffset, entry->pathSize), path) && entry->offset + entry->size <= mappedSize)
+			{
+				return std::span<const uint8_t>(mapped + entry->offset, entry->size);
+			}
+		}
+		return {};
+	}
+
+	uint32_t GetNumEntries() const
+	{
+		return IsOpen() ? header->numEntries : 0;
+	}
+
+private:
+
+	static bool IsSamePath(const std::string_view& packed, const std::string_view& path)
+	{
+		return packed.size() == path.size() && std::equal(packed.begin(), packed.end(), path.begin(),
+			[](const char& lhs, const char& rhs) { return lhs == (rhs == '\\' ? '/' : rhs); });
+	}
+
+	bool Map(const std::string& packPath)
+	{
+#if defined(_WIN32)
+		fileHandle = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize = {};
+		GetFileSizeEx(fileHandle, &fileSize);
+		mappingHandle = (fileSize.QuadPart > 0) ? CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+		if (mappingHandle == nullptr)
+		{
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+			return false;
+		}
+
+		mapped = (const uint8_t*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		mappedSize = (size_t)fileSize.QuadPart;
+		if (mapped == nullptr)
+		{
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+			mappingHandle = nullptr;
+			return false;
+		}
+#else
+		const int fileHandle = open(packPath.c_str(), O_RDONLY);
+		if (fileHandle < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStats = {};
+		if (fstat(fileHandle, &fileStats) != 0 || fileStats.st_size <= 0)
+		{
+			close(fileHandle);
+			return false;
+		}
+
+		//the mapping keeps the file alive on its own
+		void* view = mmap(nullptr, (size_t)fileStats.st_size, PROT_READ, MAP_PRIVATE, fileHandle, 0);
+		close(fileHandle);
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		mapped = (const uint8_t*)view;
+		mappedSize = (size_t)fileStats.st_size;
+#endif
+		return true;
+	}
+
+	const uint8_t*				mapped;
+	size_t						mappedSize;
+	const assetPackHeader_t*	header;
+	const assetPackEntry_t*		entries;
+	const char*					paths;
+
+#if defined(_WIN32)
+	HANDLE						fileHandle;
+	HANDLE						mappingHandle;
+#endif
+};
+
+//what virtualFileSystem_t::Open hands back. either a view into the mounted pack or a loose file read into memory.
+//move only, the view points into looseBytes for loose files
+struct assetFile_t
+{
+	assetFile_t() = default;
+	assetFile_t(const assetFile_t&) = delete;
+	assetFile_t& operator=(const assetFile_t&) = delete;
+	assetFile_t(assetFile_t&&) = default;
+	assetFile_t& operator=(assetFile_t&&) = default;
+
+	std::span<const uint8_t>	bytes;
+	std::vector<uint8_t>		looseBytes;
+
+	bool IsValid() const
+	{
+		return !bytes.empty();
+	}
+
+	const char* GetData() const
+	{
+		return (const char*)bytes.data();
+	}
+
+	size_t GetSize() const
+	{
+		return bytes.size();
+	}
+};
+
+//the one place loaders go for asset bytes. looks in the mounted pack first and falls back to the loose file under
+//assets/, so development works without a pack and anything missing from a stale pack still loads.
+//mount before any loading starts. after that lookups only read, so workers can call Open freely
+class virtualFileSystem_t
+{
+public:
+
+	virtualFileSystem_t() = default;
+	virtualFileSystem_t(const virtualFileSystem_t&) = delete;
+	virtualFileSystem_t& operator=(const virtualFileSystem_t&) = delete;
+
+	//e.g. packs/SMAA.pak, relative to assets/
+	bool Mount(const std::string& packPath)
+	{
+		const std::string fullPath = assetRoot + packPath;
+		if (!std::filesystem::exists(fullPath) || !pack.Open(fullPath))
+		{
+			return false;
+		}
+
+		printf("mounted %s (%u files) \n", packPath.c_str(), pack.GetNumEntries());
+		return true;
+	}
+
+	void Unmount()
+	{
+		pack.Close();
+	}
+
+	bool IsMounted() const
+	{
+		return pack.IsOpen();
+	}
+
+	//path relative to assets/
+	assetFile_t Open(const std::string_view& path) const
+	{
+		assetFile_t file;
+		file.bytes = pack.Find(path);
+		if (file.IsValid())
+		{
+			return file;
+		}
+
+		FILE* looseFile = fopen((assetRoot + std::string(path)).c_str(), "rb");
+		if (looseFile == nullptr)
+		{
+			return file;
+		}
+
+		fseek(looseFile, 0, SEEK_END);
+		const long fileSize = ftell(looseFile);
+		fseek(looseFile, 0, SEEK_SET);
+
+		file.looseBytes.resize(std::max(fileSize, 0L));
+		const size_t numRead = fread(file.looseBytes.data(), 1, file.looseBytes.size(), looseFile);
+		fclose(looseFile);
+
+		file.looseBytes.resize(numRead);
+		file.bytes = file.looseBytes;
+		return file;
+	}
+
+	//same as Open but as a string, for text files
+	std::string OpenText(const std::string_view& path) const
+	{
+		const assetFile_t file = Open(path);
+		return std::string(file.GetData() == nullptr ? "" : file.GetData(), file.GetSize());
+	}
+
+	bool Exists(const std::string_view& path) const
+	{
+		return !pack.Find(path).empty() || std::filesystem::exists(assetRoot + std::string(path));
+	}
+
+	static virtualFileSystem_t& Get()
+	{
+		static virtualFileSystem_t sharedFileSystem;
+		return sharedFileSystem;
+	}
+
+private:
+
+	assetPack_t		pack;
+	std::string		assetRoot = ASSET_DIR;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+//jobs posted from one thread to be run on another, e.g. GL work coming from the event handlers
+//or GUI edits that need to land on the simulation side. runs in the order they were posted
+class commandQueue_t
+{
+public:
+
+	void Push(std::function<void()>&& command)
+	{
+		std::scoped_lock lock(commandMutex);
+		commands.push_back(std::move(command));
+	}
+
+	//runs everything queued so far. anything pushed while this runs waits for the next call
+	void Execute()
+	{
+		{
+			std::scoped_lock lock(commandMutex);
+			std::swap(commands, executing);
+		}
+
+		for (auto& command : executing)
+		{
+			command();
+		}
+		executing.clear();
+	}
+
+private:
+
+	std::mutex							commandMutex;
+	std::vector<std::function<void()>>	commands;
+	std::vector<std::function<void()>>	executing;
+};
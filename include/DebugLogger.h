@@ -0,0 +1,368 @@
+#pragma once
+
+//GL debug output without the cost. the driver callback only filters and copies the message into a lock-free ring,
+//a background thread does the formatting and printing. repeats of the same message ID are counted instead of
+//printed again, and the counts go out as one line every reportInterval so a per-frame warning can't flood stdout
+class debugLogger_t
+{
+public:
+
+	//one entry per distinct message, for the GUI
+	struct loggedMessage_t
+	{
+		GLenum			source = 0;
+		GLenum			type = 0;
+		GLenum			severity = 0;
+		GLuint			id = 0;
+		std::string		text;
+		uint64_t		count = 0;
+	};
+
+	debugLogger_t()
+	{
+		for (size_t iter = 0; iter < ringSize; iter++)
+		{
+			ring[iter].sequence.store(iter, std::memory_order_relaxed);
+		}
+
+		writeIndex = 0;
+		readIndex = 0;
+		numDropped = 0;
+		numDroppedReported = 0;
+		isRunning = false;
+
+		//notifications are mostly "buffer X will use video memory", same as before
+		severityMask = SeverityBit(GL_DEBUG_SEVERITY_LOW) | SeverityBit(GL_DEBUG_SEVERITY_MEDIUM) | SeverityBit(GL_DEBUG_SEVERITY_HIGH);
+		sourceMask = ~0u;
+	}
+
+	~debugLogger_t()
+	{
+		ShutDown();
+	}
+
+	debugLogger_t(const debugLogger_t&) = delete;
+	debugLogger_t& operator=(const debugLogger_t&) = delete;
+
+	//call once the context is current. debug builds keep synchronous output so a breakpoint in the callback
+	//lands on the call that caused it, everywhere else the driver is free to report from its own thread
+	void Initialize()
+	{
+		if (glDebugMessageCallback == nullptr)
+		{
+			printf("GL debug output isn't available \n");
+			return;
+		}
+
+		glEnable(GL_DEBUG_OUTPUT);
+#if defined(DEBUG)
+		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#else
+		glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#endif
+		glDebugMessageCallback(&debugLogger_t::Callback, this);
+
+		isRunning = true;
+		formatThread = std::thread(&debugLogger_t::FormatLoop, this);
+	}
+
+	void ShutDown()
+	{
+		if (!isRunning.exchange(false))
+		{
+			return;
+		}
+
+		formatThread.join();
+	}
+
+	void SetSeverityEnabled(const GLenum& severity, const bool& isEnabled)
+	{
+		isEnabled ? severityMask.fetch_or(SeverityBit(severity)) : severityMask.fetch_and(~SeverityBit(severity));
+	}
+
+	bool IsSeverityEnabled(const GLenum& severity) const
+	{
+		return (severityMask.load(std::memory_order_relaxed) & SeverityBit(severity)) != 0;
+	}
+
+	void SetSourceEnabled(const GLenum& source, const bool& isEnabled)
+	{
+		isEnabled ? sourceMask.fetch_or(SourceBit(source)) : sourceMask.fetch_and(~SourceBit(source));
+	}
+
+	bool IsSourceEnabled(const GLenum& source) const
+	{
+		return (sourceMask.load(std::memory_order_relaxed) & SourceBit(source)) != 0;
+	}
+
+	//copy of the de-duplicated messages so far, newest ID last
+	std::vector<loggedMessage_t> GetMessages()
+	{
+		std::scoped_lock lock(messageMutex);
+		return messages;
+	}
+
+	//messages that came in while the ring was full
+	uint64_t GetNumDropped() const
+	{
+		return numDropped.load(std::memory_order_relaxed);
+	}
+
+	static const char* GetSourceName(const GLenum& source)
+	{
+		switch (source)
+		{
+			case GL_DEBUG_SOURCE_API: return "API";
+			case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+			case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+			case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+			case GL_DEBUG_SOURCE_APPLICATION: return "application";
+			default: return "other";
+		}
+	}
+
+	static const char* GetTypeName(const GLenum& type)
+	{
+		switch (type)
+		{
+			case GL_DEBUG_TYPE_ERROR: return "error";
+			case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+			case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+			case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+			case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+			case GL_DEBUG_TYPE_MARKER: return "marker";
+			case GL_DEBUG_TYPE_PUSH_GROUP: return "push group";
+			case GL_DEBUG_TYPE_POP_GROUP: return "pop group";
+			default: return "other";
+		}
+	}
+
+	static const char* GetSeverityName(const GLenum& severity)
+	{
+		switch (severity)
+		{
+			case GL_DEBUG_SEVERITY_HIGH: return "high";
+			case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+			case GL_DEBUG_SEVERITY_LOW: return "low";
+			default: return "notification";
+		}
+	}
+
+	static debugLogger_t& Get()
+	{
+		static debugLogger_t sharedLogger;
+		return sharedLogger;
+	}
+
+	static constexpr size_t					ringSize = 1024;
+	static constexpr size_t					maxMessageLength = 512;
+	static constexpr std::chrono::seconds	reportInterval = std::chrono::seconds(2);
+
+private:
+
+	struct rawMessage_t
+	{
+		std::atomic<size_t>		sequence;
+		GLenum					source;
+		GLenum					type;
+		GLenum					severity;
+		GLuint					id;
+		char					text[maxMessageLength];
+	};
+
+	static uint32_t SeverityBit(const GLenum& severity)
+	{
+		switch (severity)
+		{
+			case GL_DEBUG_SEVERITY_HIGH: return 1u << 0;
+			case GL_DEBUG_SEVERITY_MEDIUM: return 1u << 1;
+			case GL_DEBUG_SEVERITY_LOW: return 1u << 2;
+			default: return 1u << 3;
+		}
+	}
+
+	static uint32_t SourceBit(const GLenum& source)
+	{
+		//the source enums are contiguous
+		return 1u << std::min<GLenum>(source - GL_DEBUG_SOURCE_API, 31);
+	}
+
+	//can come from any thread the driver likes, more than one at a time. no locks, no allocations, no printing
+	static void APIENTRY Callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const char* message, const void* userParam)
+	{
+		debugLogger_t& logger = *(debugLogger_t*)userParam;
+		if ((logger.severityMask.load(std::memory_order_relaxed) & SeverityBit(severity)) == 0 ||
+			(logger.sourceMask.load(std::memory_order_relaxed) & SourceBit(source)) == 0)
+		{
+			return;
+		}
+
+		//bounded MPMC queue: each slot's sequence says whether it's free for this lap of the ring
+		size_t position = logger.writeIndex.load(std::memory_order_relaxed);
+		rawMessage_t* slot = nullptr;
+		while (true)
+		{
+			slot = &logger.ring[position % ringSize];
+			const intptr_t difference = (intptr_t)slot->sequence.load(std::memory_order_acquire) - (intptr_t)position;
+			if (difference == 0)
+			{
+				if (logger.writeIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+
+			else if (difference < 0)
+			{
+				//full. the formatter is behind, better to lose a message than hold up the driver
+				logger.numDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			else
+			{
+				position = logger.writeIndex.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->source = source;
+		slot->type = type;
+		slot->severity = severity;
+		slot->id = id;
+		const size_t textLength = std::min<size_t>((length < 0) ? strlen(message) : (size_t)length, maxMessageLength - 1);
+		memcpy(slot->text, message, textLength);
+		slot->text[textLength] = '\0';
+		slot->sequence.store(position + 1, std::memory_order_release);
+	}
+
+	bool Pop(rawMessage_t& out)
+	{
+		size_t position = readIndex.load(std::memory_order_relaxed);
+		while (true)
+		{
+			rawMessage_t& slot = ring[position % ringSize];
+			const intptr_t difference = (intptr_t)slot.sequence.load(std::memory_order_acquire) - (intptr_t)(position + 1);
+			if (difference == 0)
+			{
+				if (readIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					out.source = slot.source;
+					out.type = slot.type;
+					out.severity = slot.severity;
+					out.id = slot.id;
+					memcpy(out.text, slot.text, maxMessageLength);
+					slot.sequence.store(position + ringSize, std::memory_order_release);
+					return true;
+				}
+			}
+
+			else if (difference < 0)
+			{
+				return false;
+			}
+
+			else
+			{
+				position = readIndex.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void FormatLoop()
+	{
+		rawMessage_t message;
+		auto lastReport = std::chrono::steady_clock::now();
+		while (true)
+		{
+			bool hasWork = false;
+			while (Pop(message))
+			{
+				Log(message);
+				hasWork = true;
+			}
+
+			//repeats are summed up rather than printed one by one
+			const auto now = std::chrono::steady_clock::now();
+			if (now - lastReport >= reportInterval)
+			{
+				ReportRepeats();
+				lastReport = now;
+			}
+
+			if (!isRunning.load(std::memory_order_acquire))
+			{
+				ReportRepeats();
+				break;
+			}
+
+			//polling keeps the callback down to a copy, waking us up from there would cost the driver thread a syscall
+			if (!hasWork)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+		}
+	}
+
+	void Log(const rawMessage_t& message)
+	{
+		const uint64_t key = ((uint64_t)message.source << 48) ^ ((uint64_t)message.type << 32) ^ message.id;
+
+		std::scoped_lock lock(messageMutex);
+		auto existing = messageIndices.find(key);
+		if (existing != messageIndices.end())
+		{
+			messages[existing->second].count++;
+			repeats[key]++;
+			return;
+		}
+
+		messageIndices.insert({ key, messages.size() });
+		messages.push_back({ message.source, message.type, message.severity, message.id, message.text, 1 });
+
+		printf("---------------------opengl-callback-start------------\n");
+		printf("type: %s\n", GetTypeName(message.type));
+		printf("ID: %u\n", message.id);
+		printf("severity: %s\n", GetSeverityName(message.severity));
+		printf("Source: %s\n", GetSourceName(message.source));
+		printf("Message: \n%s \n", message.text);
+		printf("---------------------opengl-callback-end--------------\n");
+	}
+
+	void ReportRepeats()
+	{
+		std::scoped_lock lock(messageMutex);
+		for (const auto& [key, count] : repeats)
+		{
+			const loggedMessage_t& message = messages[messageIndices.at(key)];
+			printf("GL %s %s ID %u repeated %llu times (%llu total) \n", GetSourceName(message.source), GetTypeName(message.type), message.id,
+				(unsigned long long)count, (unsigned long long)message.count);
+		}
+		repeats.clear();
+
+		const uint64_t dropped = numDropped.load(std::memory_order_relaxed);
+		if (dropped > numDroppedReported)
+		{
+			printf("GL debug log dropped %llu messages \n", (unsigned long long)(dropped - numDroppedReported));
+			numDroppedReported = dropped;
+		}
+	}
+
+	std::array<rawMessage_t, ringSize>	ring;
+	std::atomic<size_t>					writeIndex;
+	std::atomic<size_t>					readIndex;
+	std::atomic<uint64_t>				numDropped;
+	uint64_t							numDroppedReported;
+
+	std::atomic<uint32_t>				severityMask;
+	std::atomic<uint32_t>				sourceMask;
+
+	std::thread							formatThread;
+	std::atomic<bool>					isRunning;
+
+	//only the format thread writes these, the GUI takes a copy
+	std::mutex							messageMutex;
+	std::vector<loggedMessage_t>		messages;
+	tsl::robin_map<uint64_t, size_t>	messageIndices;
+	tsl::robin_map<uint64_t, uint64_t>	repeats;
+};
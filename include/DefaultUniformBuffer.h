@@ -1,6 +1,53 @@
 #pragma once
 
+//frame fences shared by every bufferHandler_t ring. the render loop calls EndFrame once per frame after
+//everything for that frame has been submitted, and before a ring region gets written again we make sure
+//the GPU is done with the frame that last used it
+class bufferFrames_t
+{
+public:
+
+	static constexpr GLuint numFrames = 3;
+
+	static void EndFrame()
+	{
+		fences[currentFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		currentFrame = (currentFrame + 1) % numFrames;
+		frameCount++;
+
+		//only ever waits when the CPU gets more than numFrames ahead
+		GLsync& fence = fences[currentFrame];
+		if (fence != nullptr)
+		{
+			while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+			{
+			}
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	static GLuint GetCurrentFrame()
+	{
+		return currentFrame;
+	}
+
+	static uint64_t GetFrameCount()
+	{
+		return frameCount;
+	}
+
+private:
+
+	static inline GLsync		fences[numFrames] = {};
+	static inline GLuint		currentFrame = 0;
+	static inline uint64_t		frameCount = 0;
+};
+
 //change this into a payload system using templates
+//uniform and storage buffers live in a persistently mapped ring. every Update writes into the next aligned slice
+//of the current frame's region and binds just that slice, so several updates per frame (one per pass) are
+//suballocations rather than the buffer being respecified
 template<typename bufferType>
 class bufferHandler_t
 {
@@ -11,6 +58,7 @@ public:
 		data = bufferType();
 		bufferHandle = 0;
 		uniformHandle = 0;
+		bindingIndex = 0;
 	}
 
 	bufferHandler_t(bufferType payload)
@@ -18,27 +66,47 @@ public:
 		this->data = payload;
 		bufferHandle = 0;
 		uniformHandle = 0;
+		bindingIndex = 0;
 	}
 
 	//ok now we need functions to throw into this
 	void Initialize(GLuint uniformHandle, const GLenum& target = GL_UNIFORM_BUFFER, const GLenum& usage = GL_DYNAMIC_DRAW)
 	{
 		this->uniformHandle = uniformHandle;
-		glGenBuffers(1, &bufferHandle);
+		this->bindingIndex = uniformHandle;
+
+		isRing = (target == GL_UNIFORM_BUFFER || target == GL_SHADER_STORAGE_BUFFER);
+		if (isRing)
+		{
+			CreateRing(target);
+		}
+
+		else
+		{
+			glGenBuffers(1, &bufferHandle);
+		}
 		Update(target, usage);
-		glBindBufferBase(target, uniformHandle, bufferHandle);
 	}
 
 	void SetupUniforms(const GLuint& programHandle, const std::string& name, const GLuint& blockBindingIndex)
 	{
 		uniformHandle = glGetUniformBlockIndex(programHandle, name.c_str());
 		glUniformBlockBinding(programHandle, uniformHandle, blockBindingIndex);
+		bindingIndex = blockBindingIndex;
 	}
 
+	//usage only matters for buffers that aren't rings
 	void Update(const GLenum& target = GL_UNIFORM_BUFFER, const GLenum& usage = GL_DYNAMIC_DRAW, const size_t& dataSize = 0, const void* inData = nullptr)
 	{
+		const bool hasOverride = dataSize > 0 && inData != nullptr;
+		if (isRing)
+		{
+			WriteSlice(target, bindingIndex, hasOverride ? inData : &data, hasOverride ? dataSize : sizeof(data));
+			return;
+		}
+
 		glBindBuffer(target, bufferHandle);
-		if(dataSize > 0 && inData != nullptr)
+		if(hasOverride)
 		{
 			glBufferData(target, dataSize, inData, usage);
 		}
@@ -46,34 +114,114 @@ public:
 		{
 			glBufferData(target, sizeof(data), &data, usage);
 		}
+		glBindBufferBase(target, bindingIndex, bufferHandle);
 		
 		//printf("%i \n", sizeof(data));
 	}
 
-	void Override(const uint16_t uniformHandle, const GLenum& target = GL_UNIFORM_BUFFER, const GLenum& usage = GL_DYNAMIC_DRAW, const size_t& dataSize = 0, const void* inData = nullptr) const
+	void Override(const uint16_t uniformHandle, const GLenum& target = GL_UNIFORM_BUFFER, const GLenum& usage = GL_DYNAMIC_DRAW, const size_t& dataSize = 0, const void* inData = nullptr)
 	{
 		//ok so this is for overriding the data in existing shader storage buffers
 		//might have to look for a better system later
-		//glBindBuffer(target, bufferHandle); //i don't think re-setting the bufferhandle is needed here
+		if (isRing)
+		{
+			if (dataSize > 0 && inData != nullptr)
+			{
+				WriteSlice(target, uniformHandle, inData, dataSize);
+			}
+			return;
+		}
+
 		glBindBufferBase(target, uniformHandle, bufferHandle);
 		if (dataSize > 0 && inData != nullptr)
 		{
 			glBufferData(target, dataSize, inData, usage);
-			glFinish();
 		}
 	}
 
 	void BindToSlot(const uint16_t& uniformHandle, const GLenum& target = GL_UNIFORM_BUFFER)
 	{
-		//glBindBuffer(target, bufferHandle);
-		glBindBufferBase(target, uniformHandle, bufferHandle);
-		//Update(target, gl_dynamic_draw);
+		//rings rebind the latest slice
+		if (isRing)
+		{
+			glBindBufferRange(target, uniformHandle, bufferHandle, lastOffset, sizeof(data));
+		}
+
+		else
+		{
+			glBindBufferBase(target, uniformHandle, bufferHandle);
+		}
 		this->uniformHandle = uniformHandle;
+		this->bindingIndex = uniformHandle;
+	}
+
+	void ShutDown()
+	{
+		if (bufferHandle != 0)
+		{
+			if (mappedPtr != nullptr)
+			{
+				glUnmapNamedBuffer(bufferHandle);
+				mappedPtr = nullptr;
+			}
+			glDeleteBuffers(1, &bufferHandle);
+			bufferHandle = 0;
+		}
 	}
 
 	bufferType data;
 	uint32_t bufferHandle;
 	uint32_t uniformHandle;
+	uint32_t bindingIndex;
+
+	//how many times one buffer can be updated in a single frame before we have to stall
+	static constexpr GLuint slicesPerFrame = 8;
+
+private:
+
+	void CreateRing(const GLenum& target)
+	{
+		GLint alignment = 256;
+		glGetIntegerv((target == GL_SHADER_STORAGE_BUFFER) ? GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT : GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		sliceSize = (sizeof(data) + alignment - 1) / alignment * alignment;
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		const GLsizeiptr ringSize = (GLsizeiptr)(sliceSize * slicesPerFrame * bufferFrames_t::numFrames);
+		glCreateBuffers(1, &bufferHandle);
+		glNamedBufferStorage(bufferHandle, ringSize, nullptr, flags);
+		mappedPtr = (GLubyte*)glMapNamedBufferRange(bufferHandle, 0, ringSize, flags);
+	}
+
+	void WriteSlice(const GLenum& target, const GLuint& binding, const void* source, const size_t& size)
+	{
+		assert(size <= sliceSize);
+
+		if (lastFrame != bufferFrames_t::GetFrameCount())
+		{
+			lastFrame = bufferFrames_t::GetFrameCount();
+			nextSlice = 0;
+		}
+
+		if (nextSlice == slicesPerFrame)
+		{
+			//more updates this frame than the region holds. wait for the GPU to catch up and start the region over
+			glFinish();
+			nextSlice = 0;
+		}
+
+		lastOffset = ((size_t)bufferFrames_t::GetCurrentFrame() * slicesPerFrame + nextSlice) * sliceSize;
+		nextSlice++;
+
+		memcpy(mappedPtr + lastOffset, source, size);
+		glBindBufferRange(target, binding, bufferHandle, (GLintptr)lastOffset, (GLsizeiptr)size);
+	}
+
+	bool			isRing = false;
+	GLubyte*		mappedPtr = nullptr;
+	size_t			sliceSize = 0;
+	size_t			lastOffset = 0;
+	GLuint			nextSlice = 0;
+	uint64_t		lastFrame = UINT64_MAX;
 };
 
 class defaultUniformBuffer// : public uniformBuffer_t
@@ -90,6 +238,13 @@ public:
 	GLfloat				framesPerSec;
 	GLuint				totalFrames;
 
+	//last frame's geometry pass matrices, for motion vectors. the projection is the one before any jitter
+	glm::mat4			previousProjection;
+	glm::mat4			previousView;
+	glm::mat4			previousTranslation;
+	glm::vec2			projectionJitter; //NDC offset the current projection carries
+	glm::vec2			padding;
+
 	defaultUniformBuffer(const glm::mat4& projection, const glm::mat4& view,
 			const glm::mat4& translation = glm::mat4( 1 ), const glm::ivec2 resolution = defaultWindowSize ):
 		mousePosition(),
@@ -104,6 +259,10 @@ public:
 		this->view = view;
 		this->translation = translation;
 		this->resolution = resolution;
+		previousProjection = projection;
+		previousView = view;
+		previousTranslation = translation;
+		projectionJitter = glm::vec2(0);
 		totalFrames = 1;
 	}
 
@@ -116,13 +275,17 @@ public:
 		this->view = defaultCamera.view;
 		this->translation = defaultCamera.translation;
 		this->resolution = defaultCamera.resolution;
+		previousProjection = defaultCamera.projection;
+		previousView = defaultCamera.view;
+		previousTranslation = defaultCamera.translation;
+		projectionJitter = glm::vec2(0);
 		totalFrames = 1;
 	}
 
 	defaultUniformBuffer(): projection(), view(), translation(), resolution(), mousePosition(), deltaTime(0),
 	                        totalTime(0),
 	                        framesPerSec(0),
-	                        totalFrames(0)
+	                        totalFrames(0), previousProjection(1), previousView(1), previousTranslation(1), projectionJitter(0), padding(0)
 	{
 	}
 };
@@ -98,13 +98,17 @@ public:
 			default: break;
 			}
 
-			glTexParameteri(this->FBODesc.target, GL_TEXTURE_MIN_FILTER, this->FBODesc.minFilterSetting);
-			glTexParameteri(this->FBODesc.target, GL_TEXTURE_MAG_FILTER, this->FBODesc.magFilterSetting);
-			glTexParameteri(this->FBODesc.target, GL_TEXTURE_WRAP_S, this->FBODesc.wrapSSetting);
-			glTexParameteri(this->FBODesc.target, GL_TEXTURE_WRAP_T, this->FBODesc.wrapTSetting);
-			if(this->FBODesc.mipmapLevels > 0)
+			//multisample textures have no sampler state or mips, setting either is GL_INVALID_ENUM
+			if (this->FBODesc.target != GL_TEXTURE_2D_MULTISAMPLE)
 			{
-				glGenerateMipmap(this->FBODesc.target);
+				glTexParameteri(this->FBODesc.target, GL_TEXTURE_MIN_FILTER, this->FBODesc.minFilterSetting);
+				glTexParameteri(this->FBODesc.target, GL_TEXTURE_MAG_FILTER, this->FBODesc.magFilterSetting);
+				glTexParameteri(this->FBODesc.target, GL_TEXTURE_WRAP_S, this->FBODesc.wrapSSetting);
+				glTexParameteri(this->FBODesc.target, GL_TEXTURE_WRAP_T, this->FBODesc.wrapTSetting);
+				if(this->FBODesc.mipmapLevels > 0)
+				{
+					glGenerateMipmap(this->FBODesc.target);
+				}
 			}
 			UnbindTexture();
 		}
@@ -161,7 +165,7 @@ public:
 			{
 			case GL_TEXTURE_2D_MULTISAMPLE:
 				{
-					BindTexture();
+					glState_t::Get().OnTextureDeleted(handle);
 					glDeleteTextures(1, &handle);
 					glCreateTextures(FBODesc.target, 1, &handle);
 					BindTexture();
@@ -199,7 +203,7 @@ public:
 			{
 				case GL_TEXTURE_2D_MULTISAMPLE:
 				{
-					BindTexture();
+					glState_t::Get().OnTextureDeleted(handle);
 					glDeleteTextures(1, &handle);
 					glCreateTextures(FBODesc.target, 1, &handle);
 					BindTexture();
@@ -264,13 +268,13 @@ public:
 			{
 				//if non-color, draw to GL_NONE
 				GLenum attachment = GL_NONE;
-				glDrawBuffers(1, &attachment);
+				glState_t::Get().DrawBuffers(1, &attachment);
 				break;
 			}
 
 			default:
 			{
-				glDrawBuffers(1, &FBODesc.attachmentFormat);
+				glState_t::Get().DrawBuffers(1, &FBODesc.attachmentFormat);
 				break;
 			}
 			}
@@ -294,12 +298,12 @@ public:
 
 	void Bind(GLenum target = GL_FRAMEBUFFER)
 	{
-		glBindFramebuffer(target, bufferHandle);
+		glState_t::Get().BindFramebuffer(target, bufferHandle);
 	}
 
 	static void Unbind(GLenum target = GL_FRAMEBUFFER)
 	{
-		glBindFramebuffer(target, 0);
+		glState_t::Get().BindFramebuffer(target, 0);
 	}
 
 	void DrawAll()
@@ -326,13 +330,13 @@ public:
 			}
 		}
 
-		glDrawBuffers(allImages.size(), allImages.data());
+		glState_t::Get().DrawBuffers((GLsizei)allImages.size(), allImages.data());
 	}
 
 	void DrawDepth()
 	{
 		GLuint test = GL_DEPTH_ATTACHMENT;
-		glDrawBuffers(1, &test);
+		glState_t::Get().DrawBuffers(1, &test);
 	}
 
 	void DrawMultiple(const char* name)
@@ -342,10 +346,10 @@ public:
 
 	void Resize(glm::ivec3 newSize/*, bool unbind = true*/)
 	{
-		//resize the buffers
-		for (auto val : attachments | std::views::values)
+		//resize the buffers. robin_map only hands out writable values through the iterator, a range for would resize copies
+		for (auto iter = attachments.begin(); iter != attachments.end(); ++iter)
 		{
-			val.Resize(newSize);
+			iter.value().Resize(newSize);
 		}
 	}
 
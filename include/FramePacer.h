@@ -0,0 +1,160 @@
+#pragma once
+#if defined(__linux__)
+#include <time.h>
+#include <cerrno>
+#endif
+
+//frame limiter. sleeps until just before the deadline then spins the rest of the way,
+//since the scheduler can oversleep by far more than the jitter we're after.
+//deadlines are absolute so a late frame doesn't push every frame after it back
+class framePacer_t
+{
+public:
+
+	framePacer_t()
+	{
+		spinWindow = 1000000; //1ms
+		nextDeadline = 0;
+		lastFrameEnd = 0;
+		currentTarget = 0;
+		frameTimes.fill(0);
+		frameIndex = 0;
+		numFrames = 0;
+	}
+
+	//call once per frame. a target of 0 or less means uncapped, stats are still gathered
+	void Wait(const int& targetRate)
+	{
+		if (targetRate > 0)
+		{
+			const int64_t period = 1000000000LL / targetRate;
+			int64_t now = GetTimeNS();
+
+			//first capped frame, rate changed or we fell more than a frame behind. start the schedule over
+			if (targetRate != currentTarget || nextDeadline == 0 || now - nextDeadline > period)
+			{
+				nextDeadline = now + period;
+			}
+
+			SleepUntil(nextDeadline - spinWindow);
+
+			while (now < nextDeadline)
+			{
+				now = GetTimeNS();
+			}
+
+			nextDeadline += period;
+		}
+
+		else
+		{
+			nextDeadline = 0;
+		}
+
+		currentTarget = targetRate;
+
+		const int64_t frameEnd = GetTimeNS();
+		if (lastFrameEnd != 0)
+		{
+			frameTimes[frameIndex] = frameEnd - lastFrameEnd;
+			frameIndex = (frameIndex + 1) % frameTimes.size();
+			numFrames = std::min(numFrames + 1, frameTimes.size());
+		}
+		lastFrameEnd = frameEnd;
+	}
+
+	//mean frame time over the history window in milliseconds
+	double GetMeanMs() const
+	{
+		if (numFrames == 0)
+		{
+			return 0.0;
+		}
+
+		double sum = 0.0;
+		for (size_t iter = 0; iter < numFrames; iter++)
+		{
+			sum += (double)frameTimes[iter];
+		}
+		return sum / numFrames / 1e6;
+	}
+
+	double GetVarianceMs() const
+	{
+		if (numFrames < 2)
+		{
+			return 0.0;
+		}
+
+		const double mean = GetMeanMs();
+		double sum = 0.0;
+		for (size_t iter = 0; iter < numFrames; iter++)
+		{
+			const double delta = (double)frameTimes[iter] / 1e6 - mean;
+			sum += delta * delta;
+		}
+		return sum / (numFrames - 1);
+	}
+
+	double GetStdDevMs() const
+	{
+		return std::sqrt(GetVarianceMs());
+	}
+
+	//worst distance from the target frame time, or from the mean when uncapped
+	double GetMaxJitterMs() const
+	{
+		const double target = (currentTarget > 0) ? 1000.0 / currentTarget : GetMeanMs();
+		double worst = 0.0;
+		for (size_t iter = 0; iter < numFrames; iter++)
+		{
+			worst = std::max(worst, std::abs((double)frameTimes[iter] / 1e6 - target));
+		}
+		return worst;
+	}
+
+	//how long before the deadline we stop sleeping and start spinning, in nanoseconds
+	int64_t			spinWindow;
+
+private:
+
+	static int64_t GetTimeNS()
+	{
+#if defined(__linux__)
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec;
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	static void SleepUntil(const int64_t& deadline)
+	{
+		if (deadline <= GetTimeNS())
+		{
+			return;
+		}
+
+#if defined(__linux__)
+		timespec wakeTime;
+		wakeTime.tv_sec = deadline / 1000000000LL;
+		wakeTime.tv_nsec = deadline % 1000000000LL;
+
+		//absolute time so being interrupted by a signal doesn't cost us anything, just go back to sleep
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, nullptr) == EINTR)
+		{
+		}
+#else
+		std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadline)));
+#endif
+	}
+
+	int64_t							nextDeadline;
+	int64_t							lastFrameEnd;
+	int								currentTarget;
+
+	std::array<int64_t, 240>		frameTimes;
+	size_t							frameIndex;
+	size_t							numFrames;
+};
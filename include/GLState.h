@@ -0,0 +1,276 @@
+#pragma once
+
+//thin cache in front of the binds and toggles the passes hit every frame. everything that touches one of these
+//goes through here so repeats get dropped before they reach the driver, and the counters show how many made it.
+//bind-to-edit (glBindTexture then glTexImage etc) happens on a scratch unit nothing samples from,
+//so texture uploads can never knock out one of the cached sampling units
+class glState_t
+{
+public:
+
+	glState_t()
+	{
+		scratchUnit = 0;
+		issuedThisFrame = 0;
+		skippedThisFrame = 0;
+		issuedLastFrame = 0;
+		skippedLastFrame = 0;
+	}
+
+	glState_t(const glState_t&) = delete;
+	glState_t& operator=(const glState_t&) = delete;
+
+	//call once the context is current. parks the active texture unit on the scratch unit for good
+	void Initialize()
+	{
+		GLint maxUnits = 0;
+		glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxUnits);
+		scratchUnit = (GLuint)std::max(maxUnits - 1, 0);
+		glActiveTexture(GL_TEXTURE0 + scratchUnit);
+		Forget();
+	}
+
+	//drop everything we think we know. for after code that goes around the cache
+	void Forget()
+	{
+		program.reset();
+		vertexArray.reset();
+		drawFramebuffer.reset();
+		readFramebuffer.reset();
+		viewport.reset();
+		scissor.reset();
+		polygonMode.reset();
+		blendFunc.reset();
+		blendEquation.reset();
+		depthFunc.reset();
+		textureUnits.fill(std::nullopt);
+		capabilities.clear();
+		drawBuffers.clear();
+	}
+
+	void UseProgram(const GLuint& handle)
+	{
+		if (Filter(program, handle))
+		{
+			glUseProgram(handle);
+		}
+	}
+
+	void BindVertexArray(const GLuint& handle)
+	{
+		if (Filter(vertexArray, handle))
+		{
+			glBindVertexArray(handle);
+		}
+	}
+
+	void BindTextureUnit(const GLuint& unit, const GLuint& handle)
+	{
+		if (unit >= textureUnits.size() || Filter(textureUnits[unit], handle))
+		{
+			glBindTextureUnit(unit, handle);
+		}
+	}
+
+	void BindFramebuffer(const GLenum& target, const GLuint& handle)
+	{
+		bool isNew = false;
+		switch (target)
+		{
+			case GL_DRAW_FRAMEBUFFER: isNew = Filter(drawFramebuffer, handle); break;
+			case GL_READ_FRAMEBUFFER: isNew = Filter(readFramebuffer, handle); break;
+			default:
+			{
+				isNew = !(drawFramebuffer == handle && readFramebuffer == handle);
+				Count(isNew);
+				drawFramebuffer = handle;
+				readFramebuffer = handle;
+				break;
+			}
+		}
+
+		if (isNew)
+		{
+			glBindFramebuffer(target, handle);
+		}
+	}
+
+	//draw buffers are framebuffer state, so they're cached against whichever draw framebuffer is bound
+	void DrawBuffers(const GLsizei& count, const GLenum* buffers)
+	{
+		const std::vector<GLenum> requested(buffers, buffers + count);
+		if (drawFramebuffer.has_value())
+		{
+			auto cached = drawBuffers.find(drawFramebuffer.value());
+			if (cached != drawBuffers.end() && cached->second == requested)
+			{
+				Count(false);
+				return;
+			}
+			drawBuffers[drawFramebuffer.value()] = requested;
+		}
+
+		Count(true);
+		glDrawBuffers(count, buffers);
+	}
+
+	void Viewport(const GLint& x, const GLint& y, const GLsizei& width, const GLsizei& height)
+	{
+		if (Filter(viewport, glm::ivec4(x, y, width, height)))
+		{
+			glViewport(x, y, width, height);
+		}
+	}
+
+	//for viewports that have to land on fractional pixels, e.g. mapping part of the screen onto a smaller region.
+	//not cached, it just makes sure the next integer Viewport goes through
+	void ViewportF(const float& x, const float& y, const float& width, const float& height)
+	{
+		viewport.reset();
+		Count(true);
+		glViewportIndexedf(0, x, y, width, height);
+	}
+
+	void Scissor(const GLint& x, const GLint& y, const GLsizei& width, const GLsizei& height)
+	{
+		if (Filter(scissor, glm::ivec4(x, y, width, height)))
+		{
+			glScissor(x, y, width, height);
+		}
+	}
+
+	void PolygonMode(const GLenum& mode)
+	{
+		if (Filter(polygonMode, mode))
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, mode);
+		}
+	}
+
+	//blend, depth test, cull face, scissor test and friends
+	void SetEnabled(const GLenum& capability, const bool& isEnabled)
+	{
+		auto cached = capabilities.find(capability);
+		if (cached != capabilities.end() && cached->second == isEnabled)
+		{
+			Count(false);
+			return;
+		}
+
+		capabilities[capability] = isEnabled;
+		Count(true);
+		isEnabled ? glEnable(capability) : glDisable(capability);
+	}
+
+	void BlendFunc(const GLenum& source, const GLenum& dest)
+	{
+		if (Filter(blendFunc, glm::uvec2(source, dest)))
+		{
+			glBlendFunc(source, dest);
+		}
+	}
+
+	void BlendEquation(const GLenum& mode)
+	{
+		if (Filter(blendEquation, mode))
+		{
+			glBlendEquation(mode);
+		}
+	}
+
+	void DepthFunc(const GLenum& func)
+	{
+		if (Filter(depthFunc, func))
+		{
+			glDepthFunc(func);
+		}
+	}
+
+	//deleting a bound object makes GL fall back to 0, and the name can come straight back from the next glCreate*
+	void OnTextureDeleted(const GLuint& handle)
+	{
+		for (auto& unit : textureUnits)
+		{
+			if (unit == handle)
+			{
+				unit.reset();
+			}
+		}
+	}
+
+	void OnVertexArrayDeleted(const GLuint& handle)
+	{
+		if (vertexArray == handle)
+		{
+			vertexArray.reset();
+		}
+	}
+
+	//bind-to-edit goes to a unit that never gets sampled from, see Initialize
+	GLuint GetScratchUnit() const
+	{
+		return scratchUnit;
+	}
+
+	//call once per frame after the swap
+	void EndFrame()
+	{
+		issuedLastFrame = issuedThisFrame;
+		skippedLastFrame = skippedThisFrame;
+		issuedThisFrame = 0;
+		skippedThisFrame = 0;
+	}
+
+	uint32_t GetIssuedLastFrame() const
+	{
+		return issuedLastFrame;
+	}
+
+	uint32_t GetSkippedLastFrame() const
+	{
+		return skippedLastFrame;
+	}
+
+	//one context, one cache. only ever touched from the thread that owns the context
+	static glState_t& Get()
+	{
+		static glState_t sharedState;
+		return sharedState;
+	}
+
+private:
+
+	template<typename valueType>
+	bool Filter(std::optional<valueType>& cached, const valueType& value)
+	{
+		const bool isNew = !(cached.has_value() && cached.value() == value);
+		cached = value;
+		Count(isNew);
+		return isNew;
+	}
+
+	void Count(const bool& isIssued)
+	{
+		isIssued ? issuedThisFrame++ : skippedThisFrame++;
+	}
+
+	std::optional<GLuint>							program;
+	std::optional<GLuint>							vertexArray;
+	std::optional<GLuint>							drawFramebuffer;
+	std::optional<GLuint>							readFramebuffer;
+	std::optional<glm::ivec4>						viewport;
+	std::optional<glm::ivec4>						scissor;
+	std::optional<GLenum>							polygonMode;
+	std::optional<glm::uvec2>						blendFunc;
+	std::optional<GLenum>							blendEquation;
+	std::optional<GLenum>							depthFunc;
+	std::array<std::optional<GLuint>, 32>			textureUnits;
+	tsl::robin_map<GLenum, bool>					capabilities;
+	tsl::robin_map<GLuint, std::vector<GLenum>>		drawBuffers;
+
+	GLuint											scratchUnit;
+	uint32_t										issuedThisFrame;
+	uint32_t										skippedThisFrame;
+	uint32_t										issuedLastFrame;
+	uint32_t										skippedLastFrame;
+};
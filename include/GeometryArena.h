@@ -0,0 +1,490 @@
+#pragma once
+
+//same layout as the GL spec wants for glMultiDrawElementsIndirect
+struct drawElementsIndirectCommand_t
+{
+	GLuint		count = 0;
+	GLuint		instanceCount = 1;
+	GLuint		firstIndex = 0;
+	GLint		baseVertex = 0;
+	GLuint		baseInstance = 0;
+};
+
+//per draw material, std430. fetched in the shaders with gl_DrawID + drawOffset
+struct materialData_t
+{
+	glm::vec4	diffuse = glm::vec4(0);
+	glm::vec4	specular = glm::vec4(0);
+	glm::vec4	ambient = glm::vec4(0);
+	glm::vec4	emissive = glm::vec4(0);
+	glm::uvec4	flags = glm::uvec4(0); //x = has diffuse map
+	glm::uvec4	textureHandles = glm::uvec4(0); //xy = bindless diffuse handle, only filled in on the bindless path
+};
+
+//every mesh from every model added lives in one vertex buffer and one index buffer behind one VAO.
+//draws are grouped into batches that share a texture set so each batch is a single multi draw.
+//with useBindless set (and ARB_bindless_texture around) the textures come out of the material table instead,
+//so nothing gets bound and every draw goes out in one multi draw regardless of material
+class geometryArena_t
+{
+public:
+
+	geometryArena_t()
+	{
+		vertexArrayHandle = 0;
+		vertexBufferHandle = 0;
+		indexBufferHandle = 0;
+		commandBufferHandle = 0;
+		materialBufferHandle = 0;
+	}
+
+	//appends the model's meshes to the CPU side arena. call Upload once everything is in
+	void AddModel(model_t& model)
+	{
+		for (auto& mesh : model.meshes)
+		{
+			if (mesh.isCollision)
+			{
+				continue;
+			}
+
+			mesh.vertexOffset = (unsigned int)vertices.size();
+			mesh.indexOffset = (unsigned int)indices.size();
+			vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+			indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+
+			drawElementsIndirectCommand_t command;
+			command.count = mesh.numIndices;
+			command.firstIndex = mesh.indexOffset;
+			command.baseVertex = (GLint)mesh.vertexOffset;
+
+			materialData_t material;
+			material.diffuse = mesh.diffuse;
+			material.specular = mesh.specular;
+			material.ambient = mesh.ambient;
+			material.emissive = mesh.emissive;
+			material.flags.x = std::ranges::any_of(mesh.textures, [](const texture& tex) { return tex.texType == texture::textureType_t::diffuse; }) ? 1 : 0;
+
+			pendingDraws.push_back({ command, material, mesh.textures, &mesh });
+		}
+	}
+
+	//sorts the draws into batches and sends everything to GL
+	void Upload()
+	{
+		isBindless = useBindless && IsBindlessSupported();
+		if (useBindless && !isBindless)
+		{
+			printf("ARB_bindless_texture isn't available, binding textures per batch instead \n");
+		}
+
+		//group by texture set so draws that bind the same textures end up next to each other
+		if (!isBindless)
+		{
+			std::ranges::stable_sort(pendingDraws, [](const pendingDraw_t& lhs, const pendingDraw_t& rhs)
+			{
+				return GetTextureKey(lhs.textures) < GetTextureKey(rhs.textures);
+			});
+		}
+
+		materials.clear();
+		commands.clear();
+		batches.clear();
+		for (auto& draw : pendingDraws)
+		{
+			if (isBindless)
+			{
+				//one batch for everything. the diffuse map gets patched into the table once it's done streaming,
+				//until then the draw uses its material colour
+				if (batches.empty())
+				{
+					batches.push_back({ 0, 0, {} });
+				}
+
+				for (const auto& tex : draw.textures)
+				{
+					if (tex.texType == texture::textureType_t::diffuse)
+					{
+						pendingHandles.push_back({ (unsigned int)commands.size(), tex.handle });
+						break;
+					}
+				}
+				draw.material.flags.x = 0;
+			}
+
+			else if (batches.empty() || GetTextureKey(batches.back().textures) != GetTextureKey(draw.textures))
+			{
+				batches.push_back({ (GLuint)commands.size(), 0, draw.textures });
+			}
+
+			batches.back().numDraws++;
+			draw.mesh->drawIndex = (unsigned int)commands.size();
+			commands.push_back(draw.command);
+			materials.push_back(draw.material);
+		}
+		pendingDraws.clear();
+
+		glCreateBuffers(1, &vertexBufferHandle);
+		glNamedBufferStorage(vertexBufferHandle, sizeof(vertexAttribute_t) * vertices.size(), vertices.data(), 0);
+
+		glCreateBuffers(1, &indexBufferHandle);
+		glNamedBufferStorage(indexBufferHandle, sizeof(unsigned int) * indices.size(), indices.data(), 0);
+
+		glCreateBuffers(1, &commandBufferHandle);
+		glNamedBufferStorage(commandBufferHandle, sizeof(drawElementsIndirectCommand_t) * commands.size(), commands.data(), GL_DYNAMIC_STORAGE_BIT);
+
+		glCreateBuffers(1, &materialBufferHandle);
+		glNamedBufferStorage(materialBufferHandle, sizeof(materialData_t) * materials.size(), materials.data(), isBindless ? GL_DYNAMIC_STORAGE_BIT : 0);
+
+		//fixed locations that match the model shaders, whether or not the source mesh had the attribute
+		glCreateVertexArrays(1, &vertexArrayHandle);
+		glVertexArrayVertexBuffer(vertexArrayHandle, 0, vertexBufferHandle, 0, sizeof(vertexAttribute_t));
+		glVertexArrayElementBuffer(vertexArrayHandle, indexBufferHandle);
+
+		const std::pair<GLint, GLuint> attributes[] = { { 4, vertexOffset::position }, { 4, vertexOffset::normal },
+			{ 4, vertexOffset::tangent }, { 4, vertexOffset::biNormal }, { 2, vertexOffset::uv } };
+		for (GLuint attribID = 0; attribID < std::size(attributes); attribID++)
+		{
+			glEnableVertexArrayAttrib(vertexArrayHandle, attribID);
+			glVertexArrayAttribFormat(vertexArrayHandle, attribID, attributes[attribID].first, GL_FLOAT, GL_FALSE, attributes[attribID].second);
+			glVertexArrayAttribBinding(vertexArrayHandle, attribID, 0);
+		}
+
+		numDraws = (GLuint)commands.size();
+
+		//GL has its own copy now
+		vertices = {};
+		indices = {};
+	}
+
+	//turns a draw on or off without touching the batches. a hidden draw is just 0 instances
+	void SetDrawVisible(const unsigned int& drawIndex, const bool& isVisible)
+	{
+		const GLuint instanceCount = isVisible ? 1 : 0;
+		if (commands[drawIndex].instanceCount != instanceCount)
+		{
+			commands[drawIndex].instanceCount = instanceCount;
+			isDirty = true;
+		}
+	}
+
+	//only the level each LOD chain picked this frame gets drawn
+	void ApplyLODs(const model_t& model)
+	{
+		for (const auto& lodChain : model.lodChains)
+		{
+			for (size_t level = 0; level < lodChain.meshes.size(); level++)
+			{
+				SetDrawVisible(model.meshes[lodChain.meshes[level]].drawIndex, level == lodChain.currentLOD);
+			}
+		}
+	}
+
+	//one glMultiDrawElementsIndirect per batch. the program needs to be bound already
+	void Draw(const GLuint& programHandle)
+	{
+		if (numDraws == 0)
+		{
+			return;
+		}
+
+		FlushCommands();
+		BindForDraw();
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBufferHandle);
+
+		//gl_DrawID restarts at 0 for every multi draw, so each batch tells the shader where its draws start
+		const GLint drawOffsetLocation = GetDrawOffsetLocation(programHandle);
+
+		for (const auto& batch : batches)
+		{
+			BindBatchTextures(batch);
+
+			if (drawOffsetLocation != -1)
+			{
+				glUniform1ui(drawOffsetLocation, batch.firstDraw);
+			}
+
+			glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(sizeof(drawElementsIndirectCommand_t) * batch.firstDraw), batch.numDraws, 0);
+		}
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	//the whole arena numInstances times over, for scenes that keep their own per-instance data in an SSBO.
+	//one instanced draw per visible mesh. baseInstance carries the draw's index, since gl_DrawID stays 0
+	void DrawInstanced(const GLuint& numInstances)
+	{
+		if (numDraws == 0 || numInstances == 0)
+		{
+			return;
+		}
+
+		BindForDraw();
+
+		for (const auto& batch : batches)
+		{
+			BindBatchTextures(batch);
+
+			for (GLuint drawIter = batch.firstDraw; drawIter < batch.firstDraw + batch.numDraws; drawIter++)
+			{
+				//LODs that aren't picked this frame
+				const drawElementsIndirectCommand_t& command = commands[drawIter];
+				if (command.instanceCount == 0)
+				{
+					continue;
+				}
+
+				glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, command.count, GL_UNSIGNED_INT,
+					(const void*)(sizeof(unsigned int) * command.firstIndex), numInstances, command.baseVertex, drawIter);
+			}
+		}
+	}
+
+	//draws commands the GPU wrote, laid out like ours (see GetBatchRanges). one multi draw per batch either way.
+	//with a count buffer each batch reads how many of its commands are live from a GLuint at
+	//countOffset + 4 * batch index, without one every command in the batch gets read and the unused ones need 0 instances
+	void DrawIndirect(const GLuint& indirectBuffer, const GLuint& countBuffer = 0, const GLintptr& countOffset = 0)
+	{
+		if (numDraws == 0)
+		{
+			return;
+		}
+
+		BindForDraw();
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+		if (countBuffer != 0)
+		{
+			glBindBuffer(GL_PARAMETER_BUFFER, countBuffer);
+		}
+
+		for (GLuint batchIter = 0; batchIter < batches.size(); batchIter++)
+		{
+			const batch_t& batch = batches[batchIter];
+			BindBatchTextures(batch);
+
+			const void* firstCommand = (const void*)(sizeof(drawElementsIndirectCommand_t) * batch.firstDraw);
+			if (countBuffer == 0)
+			{
+				glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, firstCommand, batch.numDraws, 0);
+			}
+
+			else
+			{
+				const GLintptr batchCount = countOffset + (GLintptr)(sizeof(GLuint) * batchIter);
+				//core in 4.6, the ARB version before that
+				if (glMultiDrawElementsIndirectCount != nullptr)
+				{
+					glMultiDrawElementsIndirectCount(GL_TRIANGLES, GL_UNSIGNED_INT, firstCommand, batchCount, batch.numDraws, 0);
+				}
+
+				else
+				{
+					glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, firstCommand, batchCount, batch.numDraws, 0);
+				}
+			}
+		}
+
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		if (countBuffer != 0)
+		{
+			glBindBuffer(GL_PARAMETER_BUFFER, 0);
+		}
+	}
+
+	//sends LOD changes over. Draw does this itself, anything reading GetCommandBuffer should call it first
+	void FlushCommands()
+	{
+		if (isDirty)
+		{
+			glNamedBufferSubData(commandBufferHandle, 0, sizeof(drawElementsIndirectCommand_t) * commands.size(), commands.data());
+			isDirty = false;
+		}
+	}
+
+	//one command per draw, instanceCount 0 for LODs that are switched off
+	GLuint GetCommandBuffer() const
+	{
+		return commandBufferHandle;
+	}
+
+	//x = first draw, y = number of draws. each batch is one texture set, so one multi draw
+	std::vector<glm::uvec2> GetBatchRanges() const
+	{
+		std::vector<glm::uvec2> ranges;
+		for (const auto& batch : batches)
+		{
+			ranges.emplace_back(batch.firstDraw, batch.numDraws);
+		}
+		return ranges;
+	}
+
+	GLuint GetNumDraws() const
+	{
+		return numDraws;
+	}
+
+	size_t GetNumBatches() const
+	{
+		return batches.size();
+	}
+
+	bool IsBindless() const
+	{
+		return isBindless;
+	}
+
+	//the core profile doesn't have GL_EXTENSIONS for glGetString any more, so walk the list
+	static bool IsBindlessSupported()
+	{
+		if (glGetTextureHandleARB == nullptr || glMakeTextureHandleResidentARB == nullptr)
+		{
+			return false;
+		}
+
+		GLint numExtensions = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+		for (GLint iter = 0; iter < numExtensions; iter++)
+		{
+			if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, iter), "GL_ARB_bindless_texture") == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void ShutDown()
+	{
+		for (const auto& residentHandle : residentHandles | std::views::values)
+		{
+			glMakeTextureHandleNonResidentARB(residentHandle);
+		}
+		residentHandles.clear();
+
+		const GLuint buffers[] = { vertexBufferHandle, indexBufferHandle, commandBufferHandle, materialBufferHandle };
+		glDeleteBuffers((GLsizei)std::size(buffers), buffers);
+		glState_t::Get().OnVertexArrayDeleted(vertexArrayHandle);
+		glDeleteVertexArrays(1, &vertexArrayHandle);
+	}
+
+	//SSBO binding for materialData_t in the shaders
+	static constexpr GLuint	materialBinding = 0;
+
+private:
+
+	struct pendingDraw_t
+	{
+		drawElementsIndirectCommand_t	command;
+		materialData_t					material;
+		std::vector<texture>			textures;
+		mesh_t*							mesh;
+	};
+
+	struct batch_t
+	{
+		GLuint					firstDraw;
+		GLuint					numDraws;
+		std::vector<texture>	textures;
+	};
+
+	struct pendingHandle_t
+	{
+		unsigned int	drawIndex;
+		GLuint			textureHandle;
+	};
+
+	void BindForDraw()
+	{
+		if (isBindless)
+		{
+			ResolveBindlessHandles();
+		}
+
+		glState_t::Get().BindVertexArray(vertexArrayHandle);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, materialBinding, materialBufferHandle);
+	}
+
+	//looked up once per program, Draw runs once per adaptive tile
+	GLint GetDrawOffsetLocation(const GLuint& programHandle)
+	{
+		auto cached = drawOffsetLocations.find(programHandle);
+		if (cached == drawOffsetLocations.end())
+		{
+			cached = drawOffsetLocations.insert({ programHandle, glGetUniformLocation(programHandle, "drawOffset") }).first;
+		}
+		return cached->second;
+	}
+
+	static void BindBatchTextures(const batch_t& batch)
+	{
+		for (uint32_t texIter = 0; texIter < batch.textures.size(); texIter++)
+		{
+			batch.textures[texIter].SetActive(texIter);
+		}
+	}
+
+	//a texture handle freezes the texture, so we can't take one until the streamer has put the real image in
+	void ResolveBindlessHandles()
+	{
+		for (const auto& pending : pendingHandles)
+		{
+			if (textureStreamer_t::Get().IsPending(pending.textureHandle))
+			{
+				continue;
+			}
+
+			auto resident = residentHandles.find(pending.textureHandle);
+			if (resident == residentHandles.end())
+			{
+				const GLuint64 residentHandle = glGetTextureHandleARB(pending.textureHandle);
+				glMakeTextureHandleResidentARB(residentHandle);
+				resident = residentHandles.insert({ pending.textureHandle, residentHandle }).first;
+			}
+
+			materialData_t& material = materials[pending.drawIndex];
+			material.textureHandles.x = (GLuint)(resident->second & 0xFFFFFFFF);
+			material.textureHandles.y = (GLuint)(resident->second >> 32);
+			material.flags.x = 1;
+			glNamedBufferSubData(materialBufferHandle, sizeof(materialData_t) * pending.drawIndex, sizeof(materialData_t), &material);
+		}
+
+		std::erase_if(pendingHandles, [](const pendingHandle_t& pending) { return !textureStreamer_t::Get().IsPending(pending.textureHandle); });
+	}
+
+	static std::vector<GLuint> GetTextureKey(const std::vector<texture>& textures)
+	{
+		std::vector<GLuint> key;
+		for (const auto& tex : textures)
+		{
+			key.push_back(tex.handle);
+		}
+		return key;
+	}
+
+	std::vector<vertexAttribute_t>	vertices;
+	std::vector<unsigned int>		indices;
+	std::vector<pendingDraw_t>		pendingDraws;
+	std::vector<batch_t>			batches;
+	std::vector<drawElementsIndirectCommand_t>	commands;
+	std::vector<materialData_t>		materials;
+	bool							isDirty = false;
+	tsl::robin_map<GLuint, GLint>	drawOffsetLocations;
+
+	std::vector<pendingHandle_t>	pendingHandles;
+	tsl::robin_map<GLuint, GLuint64>	residentHandles;
+	bool							isBindless = false;
+
+public:
+
+	//set before Upload to ask for the bindless path. IsBindless says whether we actually got it
+	bool							useBindless = false;
+
+private:
+
+	GLuint							vertexArrayHandle;
+	GLuint							vertexBufferHandle;
+	GLuint							indexBufferHandle;
+	GLuint							commandBufferHandle;
+	GLuint							materialBufferHandle;
+	GLuint							numDraws = 0;
+};
@@ -20,6 +20,13 @@
 #include <list>
 #include <filesystem>
 #include <utility>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <functional>
+#include <atomic>
+#include <optional>
 //external libs
 #include <TinyExtender.h>
 namespace te = TinyExtender;
@@ -75,13 +82,26 @@ constexpr glm::ivec2 defaultViewportOrigin = glm::ivec2(0);
 //local headers
 using namespace std::placeholders;
 //internal libs
+#include "ThreadPool.h"
+#include "AssetPack.h"
+#include "FramePacer.h"
+#include "TripleBuffer.h"
+#include "CommandQueue.h"
+#include "StallDetector.h"
+#include "DebugLogger.h"
+#include "GLState.h"
 #include "Camera.h"
 #include "DefaultUniformBuffer.h"
 #include "GPUQuery.h"
 #include "VertexBuffer.h"
 #include "shaderLoader_t.h"
 #include "Texture.h"
+#include "TextureStreamer.h"
+#include "TextureCache.h"
 #include "FrameBuffer.h"
 #include "Model.h"
+#include "GeometryArena.h"
+#include "TileScaler.h"
+#include "InstanceCuller.h"
 
 
@@ -75,7 +75,7 @@ public:
 		glGenBuffers(1, &indexBufferHandle);
 		glGenVertexArrays(1, &vertexArrayHandle);
 
-		glBindVertexArray(vertexArrayHandle);
+		glState_t::Get().BindVertexArray(vertexArrayHandle);
 		glBindBuffer(gl_array_buffer, vertexBufferHandle);
 		glBindBuffer(gl_element_array_buffer, indexBufferHandle);
 
@@ -93,12 +93,13 @@ public:
 		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::tangent);
 		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::biNormal);
 		glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::uv);
-		glBindVertexArray(0);
+		glState_t::Get().BindVertexArray(0);
 	}
 
 	void Draw()
 	{
-		glBindBuffer(gl_element_array_buffer, indexBufferHandle);
+		//the VAO holds the index buffer. the program is left to the caller
+		glState_t::Get().BindVertexArray(vertexArrayHandle);
 		glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
 	}
 };
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+
+//frustum culls instances of a geometry arena on the GPU and writes the arena's draws for whatever survived, so the
+//CPU side stays one multi draw per texture batch no matter how many instances there are.
+//cullInstances tests each instance's bounding sphere against the frustum in defaultSettings and packs the survivors'
+//indices into the visible list. buildCommands then copies the arena's live commands, with the visible count as
+//their instance count, to the front of each batch's range and writes how many that was for glMultiDrawElementsIndirectCount.
+//drivers without indirect count get the same buffer with the rest of each range zeroed, so plain glMultiDrawElementsIndirect
+//draws the same thing and just skips the empty commands on the GPU
+class instanceCuller_t
+{
+public:
+
+	static constexpr GLuint		instanceBinding = 3;
+	static constexpr GLuint		visibleBinding = 4;
+	static constexpr GLuint		countBinding = 5;
+	static constexpr GLuint		templateBinding = 6;
+	static constexpr GLuint		commandBinding = 7;
+	static constexpr GLuint		batchBinding = 8;
+
+	instanceCuller_t()
+	{
+		visibleBuffer = 0;
+		countBuffer = 0;
+		commandBuffer = 0;
+		batchBuffer = 0;
+		maxInstances = 0;
+		numBatches = 0;
+		isCountSupported = false;
+		cullProgramHandle = 0;
+		buildProgramHandle = 0;
+		modelSphereLocation = -1;
+		numInstancesLocation = -1;
+		numDrawsLocation = -1;
+		numBatchesLocation = -1;
+	}
+
+	instanceCuller_t(const instanceCuller_t&) = delete;
+	instanceCuller_t& operator=(const instanceCuller_t&) = delete;
+
+	//call once the arena has all of its meshes. the programs are cullInstances and buildCommands
+	void Initialize(const geometryArena_t& arena, const GLuint& maxInstances, const GLuint& cullProgramHandle, const GLuint& buildProgramHandle)
+	{
+		this->maxInstances = maxInstances;
+		this->cullProgramHandle = cullProgramHandle;
+		this->buildProgramHandle = buildProgramHandle;
+		modelSphereLocation = glGetUniformLocation(cullProgramHandle, "modelSphere");
+		numInstancesLocation = glGetUniformLocation(cullProgramHandle, "numInstances");
+		numDrawsLocation = glGetUniformLocation(buildProgramHandle, "numDraws");
+		numBatchesLocation = glGetUniformLocation(buildProgramHandle, "numBatches");
+
+		const std::vector<glm::uvec2> batchRanges = arena.GetBatchRanges();
+		numBatches = (GLuint)batchRanges.size();
+
+		glCreateBuffers(1, &visibleBuffer);
+		glNamedBufferStorage(visibleBuffer, sizeof(GLuint) * std::max(maxInstances, 1u), nullptr, 0);
+
+		//numVisible, then one draw count per batch
+		glCreateBuffers(1, &countBuffer);
+		glNamedBufferStorage(countBuffer, sizeof(GLuint) * (1 + std::max(numBatches, 1u)), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		glCreateBuffers(1, &commandBuffer);
+		glNamedBufferStorage(commandBuffer, sizeof(drawElementsIndirectCommand_t) * std::max(arena.GetNumDraws(), 1u), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		glCreateBuffers(1, &batchBuffer);
+		glNamedBufferStorage(batchBuffer, sizeof(glm::uvec2) * std::max(numBatches, 1u), batchRanges.empty() ? nullptr : batchRanges.data(), 0);
+
+		isCountSupported = IsCountSupported();
+	}
+
+	//modelSphere is xyz centre and w radius in model space, before each instance's transform.
+	//the arena's LODs for this frame have to be applied already, the commands are taken from them
+	void Cull(geometryArena_t& arena, const GLuint& instanceBuffer, const GLuint& numInstances, const glm::vec4& modelSphere)
+	{
+		arena.FlushCommands();
+
+		const GLuint zero = 0;
+		glClearNamedBufferData(countBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+		glClearNamedBufferData(commandBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+		const GLuint numCulled = std::min(numInstances, maxInstances);
+
+		glState_t::Get().UseProgram(cullProgramHandle);
+		glUniform4fv(modelSphereLocation, 1, glm::value_ptr(modelSphere));
+		glUniform1ui(numInstancesLocation, numCulled);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, instanceBinding, instanceBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, visibleBinding, visibleBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, countBinding, countBuffer);
+		glDispatchCompute((numCulled + 63) / 64, 1, 1);
+
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+		glState_t::Get().UseProgram(buildProgramHandle);
+		glUniform1ui(numDrawsLocation, arena.GetNumDraws());
+		glUniform1ui(numBatchesLocation, numBatches);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, templateBinding, arena.GetCommandBuffer());
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, commandBinding, commandBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, batchBinding, batchBuffer);
+		glDispatchCompute((arena.GetNumDraws() + 63) / 64, 1, 1);
+
+		//the draws read the commands and counts, the vertex shader reads the visible list
+		glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+	}
+
+	//the arena's draws with the culled commands. uses the counts when the driver has them and they aren't switched off
+	void Draw(geometryArena_t& arena, const bool& useCount = true) const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, visibleBinding, visibleBuffer);
+		arena.DrawIndirect(commandBuffer, (useCount && isCountSupported) ? countBuffer : 0, sizeof(GLuint));
+	}
+
+	bool IsCountAvailable() const
+	{
+		return isCountSupported;
+	}
+
+	void ShutDown()
+	{
+		const GLuint buffers[] = { visibleBuffer, countBuffer, commandBuffer, batchBuffer };
+		glDeleteBuffers(4, buffers);
+		visibleBuffer = 0;
+		countBuffer = 0;
+		commandBuffer = 0;
+		batchBuffer = 0;
+	}
+
+private:
+
+	//core in 4.6, otherwise GL_ARB_indirect_parameters
+	static bool IsCountSupported()
+	{
+		GLint majorVersion = 0;
+		GLint minorVersion = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+		glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+		if (glMultiDrawElementsIndirectCount != nullptr && (majorVersion > 4 || (majorVersion == 4 && minorVersion >= 6)))
+		{
+			return true;
+		}
+
+		if (glMultiDrawElementsIndirectCountARB == nullptr)
+		{
+			return false;
+		}
+
+		GLint numExtensions = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+		for (GLint iter = 0; iter < numExtensions; iter++)
+		{
+			if (strcmp((const char*)glGetStringi(GL_EXTENSIONS, iter), "GL_ARB_indirect_parameters") == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	GLuint		visibleBuffer;
+	GLuint		countBuffer;
+	GLuint		commandBuffer;
+	GLuint		batchBuffer;
+	GLuint		maxInstances;
+	GLuint		numBatches;
+	bool		isCountSupported;
+
+	GLuint		cullProgramHandle;
+	GLuint		buildProgramHandle;
+	GLint		modelSphereLocation;
+	GLint		numInstancesLocation;
+	GLint		numDrawsLocation;
+	GLint		numBatchesLocation;
+};
@@ -6,15 +6,6 @@
 #define ZERO_MEM_VAR(var) memset(&var, 0, sizeof(var))
 #define ARRAY_SIZE_IN_ELEMENTS(a) (sizeof(a)/sizeof(a[0]))
 
-enum VB_TYPES {
-	INDEX_BUFFER,
-	POS_VB,
-	NORMAL_VB,
-	TEXCOORD_VB,
-	BONE_VB,
-	NUM_VBs
-};
-
 struct boneTransforms_t
 {
 	std::vector<glm::mat4> finalTransforms;
@@ -34,10 +25,6 @@ struct mesh_t
 	glm::vec4								emissive;
 	glm::vec4								reflective;
 
-	unsigned int							vertexArrayHandle;
-	unsigned int							vertexBufferHandle;
-	unsigned int							indexBufferHandle;
-
 	unsigned int							numBones;
 
 	bool									isCollision;
@@ -48,6 +35,13 @@ struct mesh_t
 	unsigned int							numVertices;
 	unsigned int							numIndices;
 
+	//model space, xyz = center w = radius
+	glm::vec4								boundingSphere;
+	//from a _LODn suffix on the node name, 0 if there isn't one
+	unsigned int							lodLevel;
+	//index into the geometry arena's draw commands
+	unsigned int							drawIndex;
+
 	mesh_t()
 	{
 		textures = std::vector<texture>();
@@ -58,10 +52,14 @@ struct mesh_t
 		emissive = glm::vec4(0);
 		reflective = glm::vec4(0);
 
-		vertexArrayHandle = 0;
 		isCollision = false;
 		vertexOffset = 0;
 		indexOffset = 0;
+		numVertices = 0;
+		numIndices = 0;
+		boundingSphere = glm::vec4(0);
+		lodLevel = 0;
+		drawIndex = 0;
 	}
 
 	mesh_t(std::vector<vertexAttribute_t> inVertices, std::vector<unsigned int> inIndices, std::vector<texture> inTextures) : 
@@ -73,13 +71,37 @@ struct mesh_t
 		emissive = glm::vec4(0);
 		reflective = glm::vec4(0);
 
-		vertexArrayHandle = 0;
 		isCollision = false;
 		vertexOffset = 0;
 		indexOffset = 0;
+		numVertices = 0;
+		numIndices = 0;
+		boundingSphere = glm::vec4(0);
+		lodLevel = 0;
+		drawIndex = 0;
 	}
 };
 
+//meshes that are the same object at different levels of detail, e.g. Rock_LOD0, Rock_LOD1...
+struct lodChain_t
+{
+	std::string					name;
+	//indices into model_t::meshes, most detailed first
+	std::vector<size_t>			meshes;
+	//covers every level in the chain
+	glm::vec4					boundingSphere = glm::vec4(0);
+	size_t						currentLOD = 0;
+};
+
+//output of the CPU half of an import
+struct meshImport_t
+{
+	mesh_t						mesh;
+	std::vector<glm::vec4>		positions;
+	bool						hasNormals = false;
+	bool						hasTangentsAndBiTangents = false;
+};
+
 #define NUM_BONES_PER_VEREX 4
 struct BoneInfo
 {
@@ -93,21 +115,6 @@ struct BoneInfo
 	}
 };
 
-struct MeshEntry {
-	MeshEntry()
-	{
-		NumIndices = 0;
-		BaseVertex = 0;
-		BaseIndex = 0;
-		MaterialIndex = 0xFFFFFFFF;
-	}
-
-	unsigned int NumIndices;
-	unsigned int BaseVertex;
-	unsigned int BaseIndex;
-	unsigned int MaterialIndex;
-};
-
 struct VertexBoneData
 {
 	unsigned int IDs[4];
@@ -143,7 +150,7 @@ class model_t
 {
 public:
 
-	model_t(const char* resourcePath = "models/SoulSpear/SoulSpear.fbx", const bool& ignoreCollision = false, const bool& keepData = false)
+	model_t(const char* resourcePath = "models/SoulSpear/SoulSpear.fbx", const bool& ignoreCollision = true, const bool& keepData = false)
 	{
 		this->resourcePath =  resourcePath;
 		position = glm::vec3(0.0f, -2.0f, -3.0f);
@@ -165,6 +172,20 @@ public:
 		m_NumBones = 0;
 	}
 
+	//hand our references back to the texture cache
+	void UnloadTextures()
+	{
+		for (const auto& mesh : meshes)
+		{
+			for (const auto& tex : mesh.textures)
+			{
+				textureCache_t::Get().Release(tex);
+			}
+		}
+
+		loadedTextures.clear();
+	}
+
 	glm::mat4 makeTransform() const
 	{
 		//make a rotation matrix
@@ -184,82 +205,96 @@ public:
 		//opts.allow_missing_vertex_position = true;
 		ufbx_error error;
 
-		auto fullpath = ASSET_DIR + resourcePath;
-
-		bool exists = std::filesystem::exists(fullpath);
+		//ufbx copies what it needs, so the file only has to live through the load
+		const assetFile_t file = virtualFileSystem_t::Get().Open(resourcePath);
 		hasBones = false;
-		assert(exists);
+		assert(file.IsValid());
 
-		dataScene = ufbx_load_file(fullpath.c_str(), &opts, &error);
+		dataScene = ufbx_load_memory(file.GetData(), file.GetSize(), &opts, &error);
 		assert(dataScene != nullptr);
 		
 		m_GlobalInverseTransform = ConvertToGLM(dataScene->root_node->geometry_transform );
 		m_GlobalInverseTransform = glm::inverse(m_GlobalInverseTransform);
 
-		glGenVertexArrays(1, &m_VAO);
-		glBindVertexArray(m_VAO);
-
-		glGenBuffers(std::size(m_Buffers), m_Buffers);
 		directory = resourcePath.substr(0, resourcePath.find_last_of('/'));
-		
-		ExtractNode(dataScene->nodes[0]);		
+
+		//CPU phase. every mesh gets built on the pool
+		std::vector<const ufbx_node*> meshNodes;
+		ExtractNode(dataScene->nodes[0], meshNodes);
+
+		std::vector<std::future<meshImport_t>> importJobs;
+		importJobs.reserve(meshNodes.size());
+		for (const auto& node : meshNodes)
+		{
+			importJobs.push_back(threadPool_t::Get().Enqueue([this, node]() { return ExtractMesh(node); }));
+		}
+
+		std::vector<meshImport_t> imports;
+		imports.reserve(importJobs.size());
+		for (auto& job : importJobs)
+		{
+			imports.push_back(job.get());
+			hasNormals |= imports.back().hasNormals;
+			hasTangentsAndBiTangents |= imports.back().hasTangentsAndBiTangents;
+		}
+
+		//upload phase. all GL work stays on this thread and meshes keep their node order
+		for (auto& import : imports)
+		{
+			UploadMesh(import);
+		}
+
+		BuildLODChains();
 
 		glm::mat4 rootTransform = ConvertToGLM(dataScene->root_node->geometry_transform);
 		globalInverse = glm::inverse(rootTransform);
 	}
 
-	void ExtractNode(const ufbx_node* node)
+	void ExtractNode(const ufbx_node* node, std::vector<const ufbx_node*>& outMeshNodes)
 	{
 		//extract mesh from this node
 
-		if (node->is_root == false)
+		//collision hulls never get drawn so don't even import them
+		if (node->is_root == false && node->mesh != nullptr && !(ignoreCollision && IsCollisionName(GetNodeName(node))))
 		{
-			ExtractMesh(node->mesh);
+			outMeshNodes.push_back(node);
 		}
 
 		//if the mesh has children, use recursion
 		for (size_t iter = 0; iter < node->children.count; iter++)
 		{
-			ExtractNode(node->children[iter]);
+			ExtractNode(node->children[iter], outMeshNodes);
 		}
 	}
 
-	void ExtractMesh(ufbx_mesh* mesh)
+	//runs on a worker, so no GL calls in here and no writing to the model
+	meshImport_t ExtractMesh(const ufbx_node* node) const
 	{
-		mesh_t newMesh;
-		newMesh.name = std::string(mesh->name.data, mesh->name.length);
+		const ufbx_mesh* mesh = node->mesh;
+		meshImport_t import;
+		mesh_t& newMesh = import.mesh;
+		newMesh.name = GetNodeName(node);
 		std::vector<vertexAttribute_t> verts;
 		std::vector<texture> textures;
 
-		//if ignore collision is on, skip the node with the prefix UCX_
-		std::string ue4String = "UCX_";
-		std::string nodeName = newMesh.name;
-		newMesh.isCollision = (nodeName.substr(0, 4) == ue4String);
-		std::vector<glm::vec4> positions;
+		newMesh.isCollision = IsCollisionName(newMesh.name);
+		newMesh.lodLevel = GetLODLevel(newMesh.name);
+		std::vector<glm::vec4>& positions = import.positions;
 
 		if (mesh->vertex_position.exists)
 		{
 			vertexAttribute_t attrib;
-			//int indicesPerVert = mesh->num_indices / mesh->vertices.count;
+			std::vector<uint32_t> tri_indices(mesh->max_face_triangles * 3);
+
+			verts.reserve(mesh->num_triangles * 3);
+			newMesh.indices.reserve(mesh->num_triangles * 3);
 
 			for (size_t index = 0; index < mesh->num_faces; index++)
 			{
 				ufbx_face face = mesh->faces.data[index];
-				std::vector<uint32_t> tri_indices(mesh->max_face_triangles * 3);
 				//per face, triangulation needed :)
 				auto numTris = ufbx_triangulate_face(tri_indices.data(), tri_indices.size(), mesh, face);
 
-				std::vector<uint32_t> indices(tri_indices.size());
-				//ufbx_vertex_stream stream = { tri_indices.data(), sizeof(glm::vec3) };
-				//auto numIndices = ufbx_generate_indices(&stream, 1, tri_indices.data(), tri_indices.size(), NULL, NULL);
-
-				//ufbx_face indface = mesh->faces[index];
-
-				for (unsigned int tri_indice : tri_indices)
-				{
-					newMesh.indices.push_back(tri_indice);
-				}
-
 				for (size_t triIter = 0; triIter < numTris * 3; triIter++)
 				{
 					auto triIndex = tri_indices[triIter];
@@ -275,7 +310,7 @@ public:
 					//normal
 					if (mesh->vertex_normal.exists)
 					{
-						hasNormals = true;
+						import.hasNormals = true;
 						auto normal = mesh->vertex_normal.values.data[mesh->vertex_normal.indices.data[triIndex]];
 						attrib.normal = glm::vec4(normal.x, normal.y, normal.z, 1.0f);
 					}
@@ -283,7 +318,7 @@ public:
 					//tangent
 					if (mesh->vertex_tangent.exists)
 					{
-						hasTangentsAndBiTangents = true;
+						import.hasTangentsAndBiTangents = true;
 						auto tangent = mesh->vertex_tangent.values.data[mesh->vertex_tangent.indices.data[triIndex]];
 						attrib.tangent = glm::vec4(tangent.x, tangent.y, tangent.z, 1.0f);
 					}
@@ -291,7 +326,7 @@ public:
 					//bitangent
 					if (mesh->vertex_bitangent.exists)
 					{
-						hasTangentsAndBiTangents = true;
+						import.hasTangentsAndBiTangents = true;
 						auto biTangent = mesh->vertex_bitangent.values.data[mesh->vertex_bitangent.indices.data[triIndex]];
 						attrib.biNormal = glm::vec4(biTangent.x, biTangent.y, biTangent.z, 1.0f);
 					}
@@ -310,20 +345,18 @@ public:
 						attrib.color = glm::vec4(color.x, color.y, color.z, color.w);
 					}
 
-					positions.push_back(attrib.position);
+					if (keepData)
+					{
+						positions.push_back(attrib.position);
+					}
 
+					//vertices are emitted per corner, so index them in emission order
+					newMesh.indices.push_back((unsigned int)verts.size());
 					verts.push_back(attrib);
 				}
 			}
 		}
 
-		newMesh.vertices = verts;
-
-		if(keepData)
-		{
-			posData.push_back(positions);
-		}
-
 		//for every material?
 		for (size_t materialIter = 0; materialIter < mesh->materials.count; materialIter++)
 		{
@@ -405,130 +438,207 @@ public:
 
 		}
 
-		LoadIntoGL(mesh, newMesh);
-
 		newMesh.vertices = std::move(verts);
 		newMesh.textures = std::move(textures);
+		newMesh.numVertices = (unsigned int)newMesh.vertices.size();
+		newMesh.numIndices = (unsigned int)newMesh.indices.size();
+		newMesh.boundingSphere = ComputeBoundingSphere(newMesh.vertices);
 
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-		meshes.push_back(newMesh);
+		return import;
 	}
 
-	texture loadMaterialTextures(ufbx_texture* tex, texture::textureType_t inTexType, std::string uniformName)
+	static std::string GetNodeName(const ufbx_node* node)
 	{
-		texture outTex;
+		//UE4 style names (UCX_, _LODn) live on the node, fall back to the mesh if the node doesn't have one
+		if (node->name.length > 0)
+		{
+			return std::string(node->name.data, node->name.length);
+		}
+		return std::string(node->mesh->name.data, node->mesh->name.length);
+	}
 
-		std::string str =	std::string(tex->absolute_filename.data, tex->absolute_filename.length);
-		const std::string& temp = str;
+	static bool IsCollisionName(const std::string& name)
+	{
+		return name.starts_with("UCX_") || name.starts_with("UBX_") || name.starts_with("USP_") || name.starts_with("UCP_");
+	}
 
-		std::string shorter = temp.substr(temp.find_last_of('/') + 1);
-		std::string localPath = directory + '/' + shorter;
+	//position of the _LOD suffix or npos if there isn't one
+	static size_t FindLODSuffix(const std::string& name)
+	{
+		std::string upper = name;
+		std::ranges::transform(upper, upper.begin(), [](const unsigned char c) { return (char)std::toupper(c); });
 
-		texture newTex(localPath, inTexType, uniformName);
-		newTex.LoadTexture();
-		outTex = newTex;
-		loadedTextures.push_back(newTex);
+		const size_t suffix = upper.rfind("_LOD");
+		if (suffix == std::string::npos || suffix + 4 >= upper.size() ||
+			!std::all_of(upper.begin() + suffix + 4, upper.end(), [](const unsigned char c) { return std::isdigit(c); }))
+		{
+			return std::string::npos;
+		}
+		return suffix;
+	}
 
-		return outTex;
+	static unsigned int GetLODLevel(const std::string& name)
+	{
+		const size_t suffix = FindLODSuffix(name);
+		return (suffix == std::string::npos) ? 0 : (unsigned int)std::stoul(name.substr(suffix + 4));
 	}
 
-	void LoadIntoGL(ufbx_mesh* umesh, mesh_t& mesh)
+	static std::string GetLODGroupName(const std::string& name)
 	{
-		glGenBuffers(1, &mesh.vertexBufferHandle);
-		glGenBuffers(1, &mesh.indexBufferHandle);
-		glGenVertexArrays(1, &mesh.vertexArrayHandle);
+		return name.substr(0, FindLODSuffix(name));
+	}
 
-		glBindVertexArray(mesh.vertexArrayHandle);
-		glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBufferHandle);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertexAttribute_t) * mesh.vertices.size(), mesh.vertices.data(), GL_STATIC_DRAW);
+	//box center and the furthest vertex from it. not the tightest sphere but close enough for LOD picking
+	static glm::vec4 ComputeBoundingSphere(const std::vector<vertexAttribute_t>& vertices)
+	{
+		if (vertices.empty())
+		{
+			return glm::vec4(0);
+		}
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.indexBufferHandle);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * mesh.indices.size(), mesh.indices.data(), GL_STATIC_DRAW);
+		glm::vec3 minBounds(FLT_MAX);
+		glm::vec3 maxBounds(-FLT_MAX);
+		for (const auto& vertex : vertices)
+		{
+			minBounds = glm::min(minBounds, glm::vec3(vertex.position));
+			maxBounds = glm::max(maxBounds, glm::vec3(vertex.position));
+		}
 
-		//might cause more issues than prevent
-		unsigned int attribID = 0;
+		const glm::vec3 center = (minBounds + maxBounds) * 0.5f;
+		float radius = 0.0f;
+		for (const auto& vertex : vertices)
+		{
+			radius = std::max(radius, glm::distance(center, glm::vec3(vertex.position)));
+		}
+		return glm::vec4(center, radius);
+	}
 
-		glEnableVertexAttribArray(attribID);
-		glVertexAttribBinding(attribID, 0);
-		glVertexAttribFormat(attribID, 4, GL_FLOAT, GL_FALSE, vertexOffset::position);
-		glVertexAttribPointer(attribID++, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::position);
+	static glm::vec4 MergeBoundingSpheres(const glm::vec4& first, const glm::vec4& second)
+	{
+		const glm::vec3 offset = glm::vec3(second) - glm::vec3(first);
+		const float distance = glm::length(offset);
 
-		if (hasNormals)
+		//one already holds the other
+		if (distance + second.w <= first.w)
 		{
-			glEnableVertexAttribArray(attribID);
-			glVertexAttribBinding(attribID, 0);
-			glVertexAttribFormat(attribID, 4, GL_FLOAT, GL_FALSE, vertexOffset::normal);
-			glVertexAttribPointer(attribID++, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::normal);
+			return first;
 		}
 
-		if (hasTangentsAndBiTangents)
+		if (distance + first.w <= second.w)
 		{
-			glEnableVertexAttribArray(attribID);
-			glVertexAttribBinding(attribID, 0);
-			glVertexAttribFormat(attribID, 4, GL_FLOAT, GL_FALSE, vertexOffset::tangent);
-			glVertexAttribPointer(attribID++, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::tangent);
-
-			glEnableVertexAttribArray(attribID);
-			glVertexAttribBinding(attribID, 0);
-			glVertexAttribFormat(attribID, 4, GL_FLOAT, GL_FALSE, vertexOffset::biNormal);
-			glVertexAttribPointer(attribID++, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::biNormal);
+			return second;
 		}
 
-		if (hasBones)
+		const float radius = (distance + first.w + second.w) * 0.5f;
+		const glm::vec3 center = glm::vec3(first) + offset * ((radius - first.w) / distance);
+		return glm::vec4(center, radius);
+	}
+
+	//group meshes by name with the _LODn suffix stripped. meshes without a suffix end up in a chain of their own
+	void BuildLODChains()
+	{
+		lodChains.clear();
+		std::map<std::string, size_t> chainLookup;
+		for (size_t meshIter = 0; meshIter < meshes.size(); meshIter++)
 		{
-			//if there are skeletal animations, load up the animation indices and weights
-			glEnableVertexAttribArray(attribID);
-			glVertexAttribBinding(attribID, 0);
-			glVertexAttribIFormat(attribID, 4, GL_UNSIGNED_INT, vertexOffset::boneIndex);
-			glVertexAttribIPointer(attribID++, 4, GL_UNSIGNED_INT, sizeof(vertexAttribute_t), (char*)vertexOffset::boneIndex);
-
-			glEnableVertexAttribArray(attribID);
-			glVertexAttribBinding(attribID, 0);
-			glVertexAttribFormat(attribID, 4, GL_FLOAT, GL_FALSE, vertexOffset::weight);
-			glVertexAttribPointer(attribID++, 4, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::weight);
+			if (meshes[meshIter].isCollision)
+			{
+				continue;
+			}
+
+			const std::string groupName = GetLODGroupName(meshes[meshIter].name);
+			auto chain = chainLookup.find(groupName);
+			if (chain == chainLookup.end())
+			{
+				chain = chainLookup.emplace(groupName, lodChains.size()).first;
+				lodChain_t newChain;
+				newChain.name = groupName;
+				newChain.boundingSphere = meshes[meshIter].boundingSphere;
+				lodChains.push_back(newChain);
+			}
+
+			lodChain_t& lodChain = lodChains[chain->second];
+			lodChain.meshes.push_back(meshIter);
+			lodChain.boundingSphere = MergeBoundingSpheres(lodChain.boundingSphere, meshes[meshIter].boundingSphere);
 		}
 
-		glEnableVertexAttribArray(attribID);
-		glVertexAttribBinding(attribID, 0);
-		glVertexAttribFormat(attribID, 2, GL_FLOAT, GL_FALSE, vertexOffset::uv);
-		glVertexAttribPointer(attribID, 2, GL_FLOAT, GL_FALSE, sizeof(vertexAttribute_t), (char*)vertexOffset::uv);
+		for (auto& lodChain : lodChains)
+		{
+			std::ranges::sort(lodChain.meshes, [this](const size_t& lhs, const size_t& rhs) { return meshes[lhs].lodLevel < meshes[rhs].lodLevel; });
+		}
 	}
 
-	glm::mat4 ConvertToGLM(const ufbx_transform& uTrans)
+	//picks a level per chain from how big its bounding sphere is on screen. every halving of the projected
+	//size below lodPixelThreshold drops one level. the smaller of the two axes counts, so a target that's
+	//only scaled down horizontally (the OA upsampler) still drops levels
+	void SelectLODs(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& viewportSize)
 	{
-		//make a new transform out of this
-		glm::mat4 outMat = glm::translate(glm::mat4(1.0f), glm::vec3(uTrans.translation.x, uTrans.translation.y, uTrans.translation.z));
-		//outMat = glm::rotate(outMat, glm::degrees(0.0f), glm::vec3(uTrans.rotation.x, uTrans.rotation.y, uTrans.rotation.z)); //why is rotation failing?
-		outMat = glm::scale(outMat, glm::vec3(uTrans.scale.x, uTrans.scale.y, uTrans.scale.z));
+		for (auto& lodChain : lodChains)
+		{
+			const glm::vec4 sphere = makeTransform() * glm::vec4(glm::vec3(lodChain.boundingSphere), 1.0f);
+			const float radius = lodChain.boundingSphere.w * std::max(scale.x, std::max(scale.y, scale.z));
+			const float viewDepth = std::max(-(view * sphere).z, 1e-4f);
 
-		return outMat;
+			//projection[0][0] and [1][1] turn a view space width and height into NDC
+			const float screenWidth = radius * 2.0f * projection[0][0] / viewDepth * viewportSize.x * 0.5f;
+			const float screenHeight = radius * 2.0f * projection[1][1] / viewDepth * viewportSize.y * 0.5f;
+			const float screenSize = std::min(screenWidth, screenHeight);
+
+			size_t level = 0;
+			if (screenSize > 0.0f && screenSize < lodPixelThreshold)
+			{
+				level = (size_t)std::floor(std::log2(lodPixelThreshold / screenSize));
+			}
+			lodChain.currentLOD = std::min(level, lodChain.meshes.size() - 1);
+		}
 	}
 
-	void Render()
+	//main thread only. drains a finished import into GL
+	void UploadMesh(meshImport_t& import)
 	{
-		glBindVertexArray(m_VAO);
+		mesh_t& newMesh = import.mesh;
 
-		for (unsigned int i = 0; i < m_Entries.size(); i++) {
-			//const unsigned int MaterialIndex = m_Entries[i].MaterialIndex;
-
-			//assert(MaterialIndex < m_Textures.size());
+		//shared through the cache, so textures used by several meshes only get decoded and uploaded once.
+		//they come back as placeholders and the streamer fills them in over the next few frames
+		for (auto& tex : newMesh.textures)
+		{
+			tex = textureCache_t::Get().Acquire(tex.path, tex.texType, tex.uniformName, tex.texDesc);
 
-			/*if (m_Textures[MaterialIndex]) {
-				m_Textures[MaterialIndex]->Bind(GL_TEXTURE0);
-			}*/
+			const bool isLoaded = std::ranges::any_of(loadedTextures, [&tex](const texture& loaded) { return loaded.handle == tex.handle; });
+			if (!isLoaded)
+			{
+				loadedTextures.push_back(tex);
+			}
+		}
 
-			glDrawElementsBaseVertex(GL_TRIANGLES,
-				m_Entries[i].NumIndices,
-				GL_UNSIGNED_INT,
-				(void*)(sizeof(unsigned int) * m_Entries[i].BaseIndex),
-				m_Entries[i].BaseVertex);
+		if (keepData)
+		{
+			posData.push_back(std::move(import.positions));
 		}
 
-		// Make sure the VAO is not changed from the outside    
-		glBindVertexArray(0);
+		meshes.push_back(std::move(newMesh));
+	}
+
+	texture loadMaterialTextures(const ufbx_texture* tex, texture::textureType_t inTexType, std::string uniformName) const
+	{
+		std::string str =	std::string(tex->absolute_filename.data, tex->absolute_filename.length);
+		const std::string& temp = str;
+
+		std::string shorter = temp.substr(temp.find_last_of('/') + 1);
+		std::string localPath = directory + '/' + shorter;
+
+		//nothing gets loaded here, UploadMesh grabs it from the texture cache
+		return texture(localPath, inTexType, uniformName);
+	}
+
+	glm::mat4 ConvertToGLM(const ufbx_transform& uTrans)
+	{
+		//make a new transform out of this
+		glm::mat4 outMat = glm::translate(glm::mat4(1.0f), glm::vec3(uTrans.translation.x, uTrans.translation.y, uTrans.translation.z));
+		//outMat = glm::rotate(outMat, glm::degrees(0.0f), glm::vec3(uTrans.rotation.x, uTrans.rotation.y, uTrans.rotation.z)); //why is rotation failing?
+		outMat = glm::scale(outMat, glm::vec3(uTrans.scale.x, uTrans.scale.y, uTrans.scale.z));
+
+		return outMat;
 	}
 
 	std::string								resourcePath;
@@ -546,6 +656,9 @@ public:
 	glm::vec3								rotation;
 
 	std::vector<texture>					loadedTextures;
+	std::vector<lodChain_t>					lodChains;
+	//projected height in pixels at or above which a chain draws its most detailed level
+	float									lodPixelThreshold = 256.0f;
 	std::vector<std::vector<glm::vec4>>		posData;	
 
 	std::vector<glm::mat4>					rawTransforms;
@@ -566,10 +679,6 @@ public:
 	unsigned int m_NumBones;
 	std::vector<BoneInfo> m_BoneInfo;
 	glm::mat4 m_GlobalInverseTransform;    
-	std::vector<MeshEntry> m_Entries;
-
-	GLuint m_VAO;
-	GLuint m_Buffers[NUM_VBs];
 
 	ufbx_scene*								dataScene;
 };
\ No newline at end of file
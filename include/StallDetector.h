@@ -0,0 +1,168 @@
+#pragma once
+
+//counts the GL calls that can make the CPU wait on the GPU (glFinish, state queries, blocking query results,
+//fence waits, readbacks into client memory) and how long each call site spent in them.
+//the entry points are routed through here by the macros at the bottom of this file, which only reach code
+//included after it, so the libraries underneath are left alone. costs a branch per call while switched off
+class stallDetector_t
+{
+public:
+
+	struct stallSite_t
+	{
+		const char*		name = nullptr;
+		const char*		file = nullptr;
+		int				line = 0;
+		uint32_t		numCalls = 0;
+		int64_t			timeNS = 0;
+
+		//__FILE__ is usually the whole path
+		const char* GetFileName() const
+		{
+			const std::string_view path(file);
+			const size_t separator = path.find_last_of("/\\");
+			return (separator == std::string_view::npos) ? file : file + separator + 1;
+		}
+	};
+
+	stallDetector_t()
+	{
+		isEnabled = false;
+	}
+
+	stallDetector_t(const stallDetector_t&) = delete;
+	stallDetector_t& operator=(const stallDetector_t&) = delete;
+
+	//runs the call, and times it when tracking is on and the call is one that actually waits
+	template<typename callType>
+	auto Track(const char* name, const char* file, const int& line, callType&& call, const bool& isStall = true)
+	{
+		if (!isEnabled || !isStall)
+		{
+			return call();
+		}
+
+		scopedTimer_t timer(*this, name, file, line);
+		return call();
+	}
+
+	//reads into client memory only stall when there's no pack buffer to write into instead
+	bool IsPackBufferUnbound() const
+	{
+		if (!isEnabled)
+		{
+			return false;
+		}
+
+		GLint packBuffer = 0;
+		glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &packBuffer);
+		return packBuffer == 0;
+	}
+
+	//call once per frame after the swap. worst offenders first
+	void EndFrame()
+	{
+		lastFrame.clear();
+		for (const auto& site : thisFrame | std::views::values)
+		{
+			lastFrame.push_back(site);
+		}
+		std::ranges::sort(lastFrame, [](const stallSite_t& lhs, const stallSite_t& rhs) { return lhs.timeNS > rhs.timeNS; });
+		thisFrame.clear();
+	}
+
+	const std::vector<stallSite_t>& GetLastFrame() const
+	{
+		return lastFrame;
+	}
+
+	double GetLastFrameMs() const
+	{
+		int64_t total = 0;
+		for (const auto& site : lastFrame)
+		{
+			total += site.timeNS;
+		}
+		return (double)total / 1e6;
+	}
+
+	uint32_t GetLastFrameCalls() const
+	{
+		uint32_t total = 0;
+		for (const auto& site : lastFrame)
+		{
+			total += site.numCalls;
+		}
+		return total;
+	}
+
+	//only GL calls get tracked and those all come from the thread that owns the context
+	static stallDetector_t& Get()
+	{
+		static stallDetector_t sharedDetector;
+		return sharedDetector;
+	}
+
+	bool		isEnabled;
+
+private:
+
+	struct scopedTimer_t
+	{
+		scopedTimer_t(stallDetector_t& detector, const char* name, const char* file, const int& line)
+			: detector(detector), name(name), file(file), line(line)
+		{
+			start = std::chrono::steady_clock::now();
+		}
+
+		~scopedTimer_t()
+		{
+			const int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			detector.Record(name, file, line, elapsed);
+		}
+
+		stallDetector_t&						detector;
+		const char*								name;
+		const char*								file;
+		int										line;
+		std::chrono::steady_clock::time_point	start;
+	};
+
+	void Record(const char* name, const char* file, const int& line, const int64_t& elapsed)
+	{
+		//__FILE__ strings are literals, so the pointer plus the line is enough to tell call sites apart
+		const uint64_t key = (uint64_t)(uintptr_t)file ^ ((uint64_t)line << 48) ^ (uint64_t)(uintptr_t)name;
+		stallSite_t& site = thisFrame[key];
+		site.name = name;
+		site.file = file;
+		site.line = line;
+		site.numCalls++;
+		site.timeNS += elapsed;
+	}
+
+	tsl::robin_map<uint64_t, stallSite_t>	thisFrame;
+	std::vector<stallSite_t>				lastFrame;
+};
+
+//GL 1.x entry points are plain exports rather than TinyExtender pointers, so both kinds go through macros.
+//a macro isn't expanded again inside its own expansion, so the inner call is the real one
+#define STALL_TRACK(name, isStall, ...) stallDetector_t::Get().Track(#name, __FILE__, __LINE__, [&]() { return name(__VA_ARGS__); }, isStall)
+
+#define glFinish() STALL_TRACK(glFinish, true)
+#define glGetError() STALL_TRACK(glGetError, true)
+#define glGetIntegerv(...) STALL_TRACK(glGetIntegerv, true, __VA_ARGS__)
+#define glGetInteger64v(...) STALL_TRACK(glGetInteger64v, true, __VA_ARGS__)
+#define glGetFloatv(...) STALL_TRACK(glGetFloatv, true, __VA_ARGS__)
+#define glGetBooleanv(...) STALL_TRACK(glGetBooleanv, true, __VA_ARGS__)
+//asking whether a result is ready never waits, asking for the result does
+#define glGetQueryObjectiv(id, pname, params) STALL_TRACK(glGetQueryObjectiv, (pname) == GL_QUERY_RESULT, id, pname, params)
+#define glGetQueryObjectuiv(id, pname, params) STALL_TRACK(glGetQueryObjectuiv, (pname) == GL_QUERY_RESULT, id, pname, params)
+#define glGetQueryObjecti64v(id, pname, params) STALL_TRACK(glGetQueryObjecti64v, (pname) == GL_QUERY_RESULT, id, pname, params)
+#define glGetQueryObjectui64v(id, pname, params) STALL_TRACK(glGetQueryObjectui64v, (pname) == GL_QUERY_RESULT, id, pname, params)
+//a zero timeout is a poll
+#define glClientWaitSync(sync, flags, timeout) STALL_TRACK(glClientWaitSync, (timeout) != 0, sync, flags, timeout)
+#define glReadPixels(...) STALL_TRACK(glReadPixels, stallDetector_t::Get().IsPackBufferUnbound(), __VA_ARGS__)
+#define glGetTexImage(...) STALL_TRACK(glGetTexImage, true, __VA_ARGS__)
+#define glGetTextureImage(...) STALL_TRACK(glGetTextureImage, true, __VA_ARGS__)
+#define glGetBufferSubData(...) STALL_TRACK(glGetBufferSubData, true, __VA_ARGS__)
+#define glGetNamedBufferSubData(...) STALL_TRACK(glGetNamedBufferSubData, true, __VA_ARGS__)
@@ -62,6 +62,39 @@ struct textureDescriptor
 	bool			isImmutable;
 };
 
+//CPU side result of decoding an image file. filled in on a worker thread, uploaded on the GL thread
+struct decodedImage_t
+{
+	std::string		fullPath;
+	unsigned char*	pixels = nullptr;
+	glm::ivec3		dimensions = glm::ivec3(0, 0, 1);
+	GLint			channels = 0;
+
+	//set instead of pixels when a cooked version of the image was found
+	gli::texture	cooked;
+
+	bool IsValid() const
+	{
+		return pixels != nullptr || !cooked.empty();
+	}
+
+	bool IsCooked() const
+	{
+		return !cooked.empty();
+	}
+
+	void Free()
+	{
+		if (pixels != nullptr)
+		{
+			stbi_image_free(pixels);
+			pixels = nullptr;
+		}
+
+		cooked = gli::texture();
+	}
+};
+
 class texture
 {
 public:
@@ -99,12 +132,12 @@ public:
 
 	void SetActive() const
 	{
-		glBindTextureUnit(handle, handle);
+		glState_t::Get().BindTextureUnit(handle, handle);
 	}
 
 	virtual void SetActive(const GLuint& texUnit) const
 	{
-		glBindTextureUnit(texUnit, handle);
+		glState_t::Get().BindTextureUnit(texUnit, handle);
 	}
 	
 	virtual void GetUniformLocation(const GLuint& programHandle)
@@ -137,41 +170,93 @@ public:
 
 	virtual void OverloadTextureUnit(const GLuint& texUnit) const
 	{
-		glActiveTexture(GL_TEXTURE0 + texUnit);
-		glBindTexture(texDesc.target, handle);
+		glState_t::Get().BindTextureUnit(texUnit, handle);
 	}
 
 	void LoadTexture()
 	{
-		stbi_set_flip_vertically_on_load(true);
-
-		const auto fullPath = ASSET_DIR + path;
-		char* data = (char*)stbi_load(fullPath.c_str(), &texDesc.dimensions.x, &texDesc.dimensions.y, &texDesc.channels, 0);
+		decodedImage_t image = DecodeImage(path);
 
 		//if stbi fails then use gli instead. if that fails give up
-		if (data == nullptr)
+		if (!image.IsValid())
 		{
-			gli::texture tex = gli::load(path);
+			const assetFile_t file = virtualFileSystem_t::Get().Open(path);
+			gli::texture tex = file.IsValid() ? gli::load(file.GetData(), file.GetSize()) : gli::texture();
 			if (!tex.empty())
 			{
 				gliLoad(tex);
 			}
 			else
 			{
-				printf("couldn't load texture: %s \n", fullPath.c_str());
+				printf("couldn't load texture: %s \n", image.fullPath.c_str());
 				return;
 			}
 		}
 
 		else
 		{
-			stbLoad(data);
+			UploadImage(image);
 		}
 	}
 
+	//where textureCooker puts the block compressed version of an image. e.g. models/a/b.tga -> cooked/models/a/b.dds
+	static std::string GetCookedPath(const std::string& path)
+	{
+		return "cooked/" + std::filesystem::path(path).replace_extension(".dds").generic_string();
+	}
+
+	//CPU only so it's safe to run on a worker. stb's flip flag is global, textureStreamer_t::Initialize sets it at startup.
+	//prefers a cooked dds over the source image when there is one
+	static decodedImage_t DecodeImage(const std::string& path)
+	{
+		decodedImage_t image;
+
+		const std::string cookedPath = GetCookedPath(path);
+		const assetFile_t cookedFile = virtualFileSystem_t::Get().Open(cookedPath);
+		if (cookedFile.IsValid())
+		{
+			image.cooked = gli::load(cookedFile.GetData(), cookedFile.GetSize());
+			if (!image.cooked.empty())
+			{
+				image.fullPath = ASSET_DIR + cookedPath;
+				image.dimensions = image.cooked.extent();
+				return image;
+			}
+		}
+
+		image.fullPath = ASSET_DIR + path;
+		const assetFile_t file = virtualFileSystem_t::Get().Open(path);
+		if (file.IsValid())
+		{
+			image.pixels = stbi_load_from_memory(file.bytes.data(), (int)file.GetSize(), &image.dimensions.x, &image.dimensions.y, &image.channels, 0);
+		}
+		return image;
+	}
+
+	//GL half of LoadTexture. the decoded pixels are freed once they've been handed to GL.
+	//if the texture already has a handle it gets respecified in place rather than replaced
+	void UploadImage(decodedImage_t& image)
+	{
+		const bool reload = (handle != 0);
+		if (image.IsCooked())
+		{
+			//cooked files are already stored bottom row first so they don't get flipped
+			gliLoad(image.cooked, false, reload);
+		}
+
+		else
+		{
+			texDesc.dimensions.x = image.dimensions.x;
+			texDesc.dimensions.y = image.dimensions.y;
+			texDesc.channels = image.channels;
+
+			stbLoad((const char*)image.pixels, reload);
+		}
+		image.Free();
+	}
+
 	virtual void ReloadTexture(const std::string& path)
 	{
-		stbi_set_flip_vertically_on_load(true);
 		const auto fullPath = ASSET_DIR + path;
 
 		char* data = (char*)stbi_load(fullPath.c_str(), &texDesc.dimensions.x, &texDesc.dimensions.y, &texDesc.channels, 0);
@@ -179,6 +264,7 @@ public:
 		if (data != nullptr)
 		{
 			stbLoad(data, true);
+			stbi_image_free(data);
 		}
 
 		else
@@ -207,9 +293,7 @@ public:
 			case 5: texDesc.minFilterSetting = GL_LINEAR_MIPMAP_LINEAR; break;
 			default: break;
 		}
-		BindTexture();
-		glTexParameteri(texDesc.target, GL_TEXTURE_MIN_FILTER, texDesc.minFilterSetting);
-		//UnbindTexture();
+		glTextureParameteri(handle, GL_TEXTURE_MIN_FILTER, texDesc.minFilterSetting);
 	}
 
 	virtual void SetMagFilter(const GLenum& magFilterSetting)
@@ -225,37 +309,25 @@ public:
 			default: break;
 		}
 
-		BindTexture();
-		glTexParameteri(texDesc.target, GL_TEXTURE_MAG_FILTER, texDesc.magFilterSetting);
-		//UnbindTexture();
+		glTextureParameteri(handle, GL_TEXTURE_MAG_FILTER, texDesc.magFilterSetting);
 	}
 
 	virtual void SetWrapS(const GLenum& wrapSetting)
 	{
 		texDesc.wrapSSetting = wrapSetting;
-		
-		BindTexture();
-		glTexParameteri(texDesc.target, GL_TEXTURE_WRAP_S, texDesc.wrapSSetting);
-		glFinish();
-		//UnbindTexture();
+		glTextureParameteri(handle, GL_TEXTURE_WRAP_S, texDesc.wrapSSetting);
 	}
 
 	virtual void SetWrapT(const GLenum& wrapSetting)
 	{
 		texDesc.wrapTSetting = wrapSetting;
-
-		BindTexture();
-		glTexParameteri(texDesc.target, GL_TEXTURE_WRAP_T, texDesc.wrapTSetting);
-		//UnbindTexture();
+		glTextureParameteri(handle, GL_TEXTURE_WRAP_T, texDesc.wrapTSetting);
 	}
 
 	virtual void SetWrapR(const GLenum& wrapSetting)
 	{
 		texDesc.wrapRSetting = wrapSetting;
-
-		BindTexture();
-		glTexParameteri(texDesc.target, GL_TEXTURE_WRAP_R, texDesc.wrapRSetting);
-		UnbindTexture();
+		glTextureParameteri(handle, GL_TEXTURE_WRAP_R, texDesc.wrapRSetting);
 	}
 
 	virtual void SetPath(const char* newPath)
@@ -434,14 +506,20 @@ private:
 			glTexParameteri(texDesc.target, GL_TEXTURE_MAG_FILTER, texDesc.magFilterSetting);
 		}
 
-		float aniso = 0.0f;
-		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso); //throws out an openGL error but works anyway. not sure how to fix
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, GetMaxAnisotropy());
 	}
 
-	void gliLoad(gli::texture tex)
+	//the limit textureStreamer_t::Initialize queried, defined after it in TextureStreamer.h
+	static float GetMaxAnisotropy();
+
+	void gliLoad(gli::texture tex, const bool& flip = true, const bool& reload = false)
 	{
-		tex = gli::flip(tex);
+		//gli can only flip uncompressed and S3TC textures
+		if (flip && (!gli::is_compressed(tex.format()) || gli::is_s3tc_compressed(tex.format())))
+		{
+			tex = gli::flip(tex);
+		}
+
 		gli::gl GL(gli::gl::PROFILE_GL33);
 		gli::gl::format const gliFormat = GL.translate(tex.format(), tex.swizzles());
 		texDesc.target = GL.translate(tex.target());
@@ -456,7 +534,10 @@ private:
 
 		bool compressed = gli::is_compressed(tex.format());
 
-		glGenTextures(1, &handle);
+		if (!reload)
+		{
+			glGenTextures(1, &handle);
+		}
 		glBindTexture(texDesc.target, handle);
 
 		switch (texDesc.target)
@@ -479,12 +560,18 @@ private:
 			glTexParameteri(texDesc.target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(tex.levels() - 1));
 			glTexParameteriv(texDesc.target, GL_TEXTURE_SWIZZLE_RGBA, &gliFormat.Swizzles[0]);
 
+			//compressed data goes into immutable storage that has room for the whole mip chain up front
+			if (compressed)
+			{
+				glTexStorage2D(texDesc.target, texDesc.mipmapLevels, texDesc.internalFormat, texDesc.dimensions.x, texDesc.dimensions.y);
+				texDesc.isImmutable = true;
+			}
+
 			for (unsigned int level = 0; level < tex.levels(); level++)
 			{
 				glm::tvec3<GLsizei> extents(tex.extent(level));
 				if(compressed)
 				{
-					glTexStorage2D(texDesc.target, texDesc.currentMipmapLevel, texDesc.internalFormat, texDesc.dimensions.x, texDesc.dimensions.y);
 					glCompressedTexSubImage2D(
 						texDesc.target, static_cast<GLint>(level), 0, 0, extents.x, extents.y,
 						texDesc.internalFormat, static_cast<GLsizei>(tex.size(level)), tex.data(0, 0, level));
@@ -492,10 +579,15 @@ private:
 
 				else
 				{
-					texDesc.currentMipmapLevel = 0;
-					glTexImage2D(texDesc.target, texDesc.currentMipmapLevel, texDesc.internalFormat, texDesc.dimensions.x, texDesc.dimensions.y, texDesc.border, texDesc.format, texDesc.dataType, tex.data(0, 0, level));
+					glTexImage2D(texDesc.target, static_cast<GLint>(level), texDesc.internalFormat, extents.x, extents.y, texDesc.border, texDesc.format, texDesc.dataType, tex.data(0, 0, level));
 				}
 			}
+
+			//use the mips we were given rather than leaving them to waste
+			if (tex.levels() > 1 && (texDesc.minFilterSetting == GL_LINEAR || texDesc.minFilterSetting == GL_NEAREST))
+			{
+				texDesc.minFilterSetting = GL_LINEAR_MIPMAP_LINEAR;
+			}
 			break;
 		}
 
@@ -0,0 +1,125 @@
+#pragma once
+
+//process wide cache so meshes and materials that point at the same file share one decode and one GL texture.
+//keyed by the normalized path plus anything that changes how the texture is created (format, sampler, mips)
+class textureCache_t
+{
+public:
+
+	textureCache_t()
+	{
+		//streamer has to outlive the cache, entries may still be streaming when we shut down
+		textureStreamer_t::Get();
+		numHits = 0;
+		numMisses = 0;
+	}
+
+	textureCache_t(const textureCache_t&) = delete;
+	textureCache_t& operator=(const textureCache_t&) = delete;
+
+	//returns a texture sharing the cached GL handle, streaming it in on a miss
+	texture Acquire(const std::string& path, const texture::textureType_t& texType = texture::textureType_t::image,
+		const std::string& uniformName = "defaultTexture", const textureDescriptor& texDesc = textureDescriptor())
+	{
+		const std::string key = MakeKey(path, texDesc);
+
+		auto entry = entries.find(key);
+		if (entry != entries.end())
+		{
+			numHits++;
+			entry.value().refCount++;
+
+			//same pixels, but the caller still gets its own type and uniform name
+			texture result = entry->second.tex;
+			result.SetTextureType(texType);
+			result.uniformName = uniformName;
+			return result;
+		}
+
+		numMisses++;
+		texture newTex(NormalizePath(path), texType, uniformName, texDesc);
+		textureStreamer_t::Get().Stream(newTex);
+		entries[key] = { newTex, 1 };
+		return newTex;
+	}
+
+	//drops a reference. the GL texture goes away once nobody is using it
+	void Release(const texture& tex)
+	{
+		auto entry = entries.find(MakeKey(tex.path, tex.texDesc));
+		if (entry == entries.end())
+		{
+			return;
+		}
+
+		if (--entry.value().refCount == 0)
+		{
+			GLuint handle = entry->second.tex.handle;
+			textureStreamer_t::Get().Cancel(handle);
+			glState_t::Get().OnTextureDeleted(handle);
+			glDeleteTextures(1, &handle);
+			entries.erase(entry);
+		}
+	}
+
+	void ShutDown()
+	{
+		for (auto& entry : entries)
+		{
+			GLuint handle = entry.second.tex.handle;
+			textureStreamer_t::Get().Cancel(handle);
+			glState_t::Get().OnTextureDeleted(handle);
+			glDeleteTextures(1, &handle);
+		}
+		entries.clear();
+	}
+
+	size_t GetNumHits() const
+	{
+		return numHits;
+	}
+
+	size_t GetNumMisses() const
+	{
+		return numMisses;
+	}
+
+	size_t GetNumEntries() const
+	{
+		return entries.size();
+	}
+
+	static textureCache_t& Get()
+	{
+		static textureCache_t sharedCache;
+		return sharedCache;
+	}
+
+private:
+
+	struct cacheEntry_t
+	{
+		texture		tex;
+		size_t		refCount;
+	};
+
+	static std::string NormalizePath(const std::string& path)
+	{
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	static std::string MakeKey(const std::string& path, const textureDescriptor& texDesc)
+	{
+		std::string key = NormalizePath(path);
+		for (const GLint setting : { (GLint)texDesc.target, texDesc.internalFormat, texDesc.mipmapLevels, (GLint)texDesc.minFilterSetting,
+			(GLint)texDesc.magFilterSetting, (GLint)texDesc.wrapSSetting, (GLint)texDesc.wrapTSetting, (GLint)texDesc.wrapRSetting })
+		{
+			key += '|' + std::to_string(setting);
+		}
+		return key;
+	}
+
+	tsl::robin_map<std::string, cacheEntry_t>	entries;
+	size_t										numHits;
+	size_t										numMisses;
+};
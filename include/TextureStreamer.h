@@ -0,0 +1,395 @@
+#pragma once
+
+//hands back textures straight away with a 1x1 placeholder, decodes on the thread pool and
+//trickles the pixels into GL through a persistently mapped unpack buffer a slice per frame.
+//the placeholder and the final image share a GL handle so copies of the texture don't need patching
+class textureStreamer_t
+{
+public:
+
+	explicit textureStreamer_t(const size_t& stagingSize = 12 * 1024 * 1024, const GLuint& numSlices = 3)
+	{
+		//make sure the pool outlives us so pending decodes are finished before we get torn down
+		threadPool_t::Get();
+
+		this->numSlices = numSlices;
+		this->sliceSize = stagingSize / numSlices;
+		this->stagingSize = sliceSize * numSlices;
+		stagingBuffer = 0;
+		stagingPtr = nullptr;
+		currentSlice = 0;
+		bytesLastFrame = 0;
+		totalBytes = 0;
+		maxAnisotropy = 0.0f;
+		sliceFences.resize(numSlices, nullptr);
+	}
+
+	~textureStreamer_t()
+	{
+		//no GL context to talk to by now, just make sure nothing leaks on the CPU side
+		for (auto& job : jobs)
+		{
+			if (!job.isDecoded)
+			{
+				job.image = job.decode.get();
+			}
+			job.image.Free();
+		}
+	}
+
+	textureStreamer_t(const textureStreamer_t&) = delete;
+	textureStreamer_t& operator=(const textureStreamer_t&) = delete;
+
+	//on the GL thread before anything streams. stb's flip flag is global and the workers read it mid decode,
+	//so it's set here once rather than per texture
+	void Initialize()
+	{
+		stbi_set_flip_vertically_on_load(true);
+		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+	}
+
+	//gives tex a placeholder handle right away and queues up the real image
+	void Stream(texture& tex)
+	{
+		CreatePlaceholder(tex);
+
+		streamJob_t job;
+		job.handle = tex.handle;
+		job.texDesc = tex.texDesc;
+		job.path = tex.path;
+
+		const std::string path = tex.path;
+		job.decode = threadPool_t::Get().Enqueue([path]() { return texture::DecodeImage(path); });
+
+		jobs.push_back(std::move(job));
+	}
+
+	//call once per frame on the GL thread. uploads at most one slice worth of pixels
+	void Update()
+	{
+		bytesLastFrame = 0;
+		if (jobs.empty())
+		{
+			return;
+		}
+
+		//pick up any finished decodes
+		for (auto& job : jobs)
+		{
+			if (!job.isDecoded && job.decode.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				job.image = job.decode.get();
+				job.isDecoded = true;
+
+				if (job.isCancelled)
+				{
+					continue;
+				}
+
+				if (job.image.IsCooked())
+				{
+					//cooked textures go up whole through gliLoad, see UploadSlice
+					continue;
+				}
+
+				if (job.image.IsValid())
+				{
+					BeginUpload(job);
+				}
+
+				else
+				{
+					printf("couldn't load texture: %s \n", job.image.fullPath.c_str());
+					job.isFinished = true;
+				}
+			}
+		}
+
+		for (auto& job : jobs)
+		{
+			if (job.isCancelled && job.isDecoded)
+			{
+				job.image.Free();
+				job.isFinished = true;
+			}
+		}
+
+		UploadSlice();
+
+		std::erase_if(jobs, [](const streamJob_t& job) { return job.isFinished; });
+	}
+
+	//stop streaming into a texture that's about to be deleted. any decode still in flight gets freed when it lands
+	void Cancel(const GLuint& handle)
+	{
+		for (auto& job : jobs)
+		{
+			if (job.handle == handle)
+			{
+				job.isCancelled = true;
+			}
+		}
+	}
+
+	size_t GetNumPending() const
+	{
+		return jobs.size();
+	}
+
+	//true while the texture is still the placeholder or partway through uploading
+	bool IsPending(const GLuint& handle) const
+	{
+		return std::ranges::any_of(jobs, [&handle](const streamJob_t& job) { return job.handle == handle && !job.isCancelled; });
+	}
+
+	size_t GetBytesLastFrame() const
+	{
+		return bytesLastFrame;
+	}
+
+	size_t GetTotalBytes() const
+	{
+		return totalBytes;
+	}
+
+	size_t GetBudget() const
+	{
+		return sliceSize;
+	}
+
+	float GetMaxAnisotropy() const
+	{
+		return maxAnisotropy;
+	}
+
+	void ShutDown()
+	{
+		for (auto& fence : sliceFences)
+		{
+			if (fence != nullptr)
+			{
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+		}
+
+		if (stagingBuffer != 0)
+		{
+			glUnmapNamedBuffer(stagingBuffer);
+			glDeleteBuffers(1, &stagingBuffer);
+			stagingBuffer = 0;
+			stagingPtr = nullptr;
+		}
+	}
+
+	//process wide streamer, same idea as threadPool_t::Get
+	static textureStreamer_t& Get()
+	{
+		static textureStreamer_t sharedStreamer;
+		return sharedStreamer;
+	}
+
+private:
+
+	struct streamJob_t
+	{
+		GLuint							handle = 0;
+		textureDescriptor				texDesc;
+		std::string						path;
+		std::future<decodedImage_t>		decode;
+		decodedImage_t					image;
+		GLenum							format = GL_RGBA;
+		size_t							rowSize = 0;
+		GLint							nextRow = 0;
+		bool							isDecoded = false;
+		bool							isFinished = false;
+		bool							isCancelled = false;
+	};
+
+	static GLenum ChannelsToFormat(const GLint& channels)
+	{
+		switch (channels)
+		{
+			case 1: return GL_RED;
+			case 2: return GL_RG;
+			case 3: return GL_RGB;
+			default: return GL_RGBA;
+		}
+	}
+
+	void CreatePlaceholder(texture& tex) const
+	{
+		//flat normal for normal maps so lighting doesn't go weird while we wait, mid grey for everything else
+		const GLubyte grey[4] = { 128, 128, 128, 255 };
+		const GLubyte flatNormal[4] = { 128, 128, 255, 255 };
+		const GLubyte* pixel = (tex.texType == texture::textureType_t::normal) ? flatNormal : grey;
+
+		glGenTextures(1, &tex.handle);
+		glBindTexture(GL_TEXTURE_2D, tex.handle);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void CreateStaging()
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &stagingBuffer);
+		glNamedBufferStorage(stagingBuffer, stagingSize, nullptr, flags);
+		stagingPtr = (GLubyte*)glMapNamedBufferRange(stagingBuffer, 0, stagingSize, flags);
+	}
+
+	//respecify the placeholder at full size. the pixels come in later through the staging buffer
+	void BeginUpload(streamJob_t& job) const
+	{
+		const textureDescriptor& desc = job.texDesc;
+		job.format = ChannelsToFormat(job.image.channels);
+		job.rowSize = (size_t)job.image.dimensions.x * job.image.channels;
+
+		//mutable storage has no DSA respecify, so only this part binds (on glState_t's scratch unit)
+		glBindTexture(GL_TEXTURE_2D, job.handle);
+		glTexImage2D(GL_TEXTURE_2D, 0, desc.internalFormat, job.image.dimensions.x, job.image.dimensions.y, 0, job.format, GL_UNSIGNED_BYTE, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glTextureParameteri(job.handle, GL_TEXTURE_WRAP_S, desc.wrapSSetting);
+		glTextureParameteri(job.handle, GL_TEXTURE_WRAP_T, desc.wrapTSetting);
+		glTextureParameteri(job.handle, GL_TEXTURE_MIN_FILTER, desc.minFilterSetting);
+		glTextureParameteri(job.handle, GL_TEXTURE_MAG_FILTER, desc.magFilterSetting);
+		glTextureParameterf(job.handle, GL_TEXTURE_MAX_ANISOTROPY, maxAnisotropy);
+	}
+
+	void FinishUpload(streamJob_t& job)
+	{
+		if (job.texDesc.mipmapLevels > 0)
+		{
+			glGenerateTextureMipmap(job.handle);
+		}
+
+		job.image.Free();
+		job.isFinished = true;
+	}
+
+	void UploadSlice()
+	{
+		if (stagingBuffer == 0)
+		{
+			CreateStaging();
+		}
+
+		//if the GPU hasn't finished reading this slice yet, try again next frame instead of stalling
+		GLsync& fence = sliceFences[currentSlice];
+		if (fence != nullptr)
+		{
+			if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) == GL_TIMEOUT_EXPIRED)
+			{
+				return;
+			}
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		const size_t sliceStart = currentSlice * sliceSize;
+		size_t sliceOffset = 0;
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBuffer);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (auto& job : jobs)
+		{
+			if (!job.isDecoded || job.isFinished)
+			{
+				continue;
+			}
+
+			//cooked mip chains are already block compressed and a fraction of the size, so they skip the staging
+			//buffer and go straight through gliLoad. they still count against this frame's budget
+			if (job.image.IsCooked())
+			{
+				const size_t cookedSize = job.image.cooked.size();
+				if (sliceOffset + bytesLastFrame > 0 && sliceOffset + bytesLastFrame + cookedSize > sliceSize)
+				{
+					break;
+				}
+
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+				texture target(job.path, texture::textureType_t::image, "", job.texDesc);
+				target.handle = job.handle;
+				target.UploadImage(job.image);
+
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBuffer);
+				glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+				bytesLastFrame += cookedSize;
+				job.isFinished = true;
+				continue;
+			}
+
+			const GLint width = job.image.dimensions.x;
+			const GLint height = job.image.dimensions.y;
+
+			//a single row bigger than a whole slice, nothing for it but to send it straight from client memory
+			if (job.rowSize > sliceSize)
+			{
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				glTextureSubImage2D(job.handle, 0, 0, 0, width, height, job.format, GL_UNSIGNED_BYTE, job.image.pixels);
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingBuffer);
+				bytesLastFrame += job.rowSize * height;
+				FinishUpload(job);
+				continue;
+			}
+
+			const GLint rowsThatFit = (GLint)((sliceSize - sliceOffset) / job.rowSize);
+			if (rowsThatFit == 0)
+			{
+				break;
+			}
+
+			const GLint numRows = std::min(rowsThatFit, height - job.nextRow);
+			const size_t numBytes = job.rowSize * numRows;
+
+			memcpy(stagingPtr + sliceStart + sliceOffset, job.image.pixels + job.rowSize * job.nextRow, numBytes);
+			glTextureSubImage2D(job.handle, 0, 0, job.nextRow, width, numRows, job.format, GL_UNSIGNED_BYTE, (const void*)(sliceStart + sliceOffset));
+
+			sliceOffset += numBytes;
+			job.nextRow += numRows;
+
+			if (job.nextRow == height)
+			{
+				FinishUpload(job);
+			}
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (sliceOffset > 0)
+		{
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			currentSlice = (currentSlice + 1) % numSlices;
+		}
+
+		bytesLastFrame += sliceOffset;
+		totalBytes += bytesLastFrame;
+	}
+
+	std::vector<streamJob_t>	jobs;
+
+	GLuint						stagingBuffer;
+	GLubyte*					stagingPtr;
+	size_t						stagingSize;
+	size_t						sliceSize;
+	GLuint						numSlices;
+	GLuint						currentSlice;
+	std::vector<GLsync>			sliceFences;
+
+	size_t						bytesLastFrame;
+	size_t						totalBytes;
+	float						maxAnisotropy;
+};
+
+inline float texture::GetMaxAnisotropy()
+{
+	return textureStreamer_t::Get().GetMaxAnisotropy();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+//small fixed size worker pool for CPU side loading work (mesh building, image decoding)
+//GL calls must never be made from inside a job, hand the results back to the main thread instead
+class threadPool_t
+{
+public:
+
+	explicit threadPool_t(size_t numWorkers = 0)
+	{
+		if (numWorkers == 0)
+		{
+			numWorkers = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		isRunning = true;
+		for (size_t iter = 0; iter < numWorkers; iter++)
+		{
+			workers.emplace_back(&threadPool_t::WorkerLoop, this);
+		}
+	}
+
+	~threadPool_t()
+	{
+		{
+			std::scoped_lock lock(jobMutex);
+			isRunning = false;
+		}
+
+		jobSignal.notify_all();
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	threadPool_t(const threadPool_t&) = delete;
+	threadPool_t& operator=(const threadPool_t&) = delete;
+
+	//queue up a job and get a future for its result
+	template<typename job_t>
+	auto Enqueue(job_t&& job) -> std::future<std::invoke_result_t<job_t>>
+	{
+		using result_t = std::invoke_result_t<job_t>;
+
+		//packaged_task is move only, std::function needs something copyable
+		auto task = std::make_shared<std::packaged_task<result_t()>>(std::forward<job_t>(job));
+		std::future<result_t> result = task->get_future();
+		{
+			std::scoped_lock lock(jobMutex);
+			jobs.emplace([task]() { (*task)(); });
+		}
+
+		jobSignal.notify_one();
+		return result;
+	}
+
+	size_t GetNumWorkers() const
+	{
+		return workers.size();
+	}
+
+	//process wide pool so every loader isn't spinning up its own threads
+	static threadPool_t& Get()
+	{
+		static threadPool_t sharedPool;
+		return sharedPool;
+	}
+
+private:
+
+	void WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock lock(jobMutex);
+				jobSignal.wait(lock, [this]() { return !isRunning || !jobs.empty(); });
+
+				if (!isRunning && jobs.empty())
+				{
+					return;
+				}
+
+				job = std::move(jobs.front());
+				jobs.pop();
+			}
+
+			job();
+		}
+	}
+
+	std::vector<std::thread>				workers;
+	std::queue<std::function<void()>>		jobs;
+	std::mutex								jobMutex;
+	std::condition_variable					jobSignal;
+	bool									isRunning;
+};
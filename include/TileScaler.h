@@ -0,0 +1,228 @@
+#pragma once
+
+//splits the screen into a grid of tiles and gives each one its own horizontal scale, picked from how many
+//SMAA edges the tile had a frame or two ago. tiles are packed left to right per row into a render target the
+//size of the screen, so flat tiles take up fewer pixels. the table lives in an SSBO the shaders can read,
+//and the edge counts come back through a persistently mapped buffer behind a fence so nothing ever waits on them
+class tileScaler_t
+{
+public:
+
+	static constexpr glm::uvec2					gridSize = glm::uvec2(16, 9);
+	static constexpr GLuint						maxTiles = 256;
+	static constexpr uint32_t					numLevels = 4;
+	static constexpr std::array<float, 4>		scaleLevels = { 0.25f, 0.5f, 0.75f, 1.0f };
+
+	//xy = screen x and width, zw = atlas x and width. rows line up with the screen so y needs no mapping
+	struct tile_t
+	{
+		glm::vec4 rect;
+	};
+
+	tileScaler_t()
+	{
+		resolution = glm::ivec2(0);
+		tileSize = glm::ivec2(0);
+		tableBuffer = 0;
+		countBuffer = 0;
+		readbackBuffer = 0;
+		readbackPtr = nullptr;
+		readbackFence = nullptr;
+		levels.fill(numLevels - 1);
+		countedAreas.fill(0.0f);
+	}
+
+	tileScaler_t(const tileScaler_t&) = delete;
+	tileScaler_t& operator=(const tileScaler_t&) = delete;
+
+	void Initialize(const glm::ivec2& resolution)
+	{
+		glCreateBuffers(1, &tableBuffer);
+		glNamedBufferStorage(tableBuffer, sizeof(glm::uvec4) + sizeof(tile_t) * maxTiles, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		glCreateBuffers(1, &countBuffer);
+		glNamedBufferStorage(countBuffer, sizeof(GLuint) * maxTiles, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glCreateBuffers(1, &readbackBuffer);
+		glNamedBufferStorage(readbackBuffer, sizeof(GLuint) * maxTiles, nullptr, flags);
+		readbackPtr = (const GLuint*)glMapNamedBufferRange(readbackBuffer, 0, sizeof(GLuint) * maxTiles, flags);
+
+		Resize(resolution);
+	}
+
+	void Resize(const glm::ivec2& resolution)
+	{
+		this->resolution = resolution;
+		tileSize = (resolution + glm::ivec2(gridSize) - 1) / glm::ivec2(gridSize);
+		Rebuild();
+	}
+
+	//call at the start of the frame. picks up edge counts that have landed and re-packs the tiles if any changed
+	void Update()
+	{
+		if (readbackFence == nullptr || glClientWaitSync(readbackFence, 0, 0) == GL_TIMEOUT_EXPIRED)
+		{
+			return;
+		}
+
+		glDeleteSync(readbackFence);
+		readbackFence = nullptr;
+
+		bool isChanged = false;
+		for (GLuint tileIter = 0; tileIter < gridSize.x * gridSize.y; tileIter++)
+		{
+			const float area = countedAreas[tileIter];
+			const float density = (area > 0.0f) ? (float)readbackPtr[tileIter] / area : 0.0f;
+
+			uint32_t level = 0;
+			while (level < numLevels - 1 && density >= densityThresholds[level])
+			{
+				level++;
+			}
+
+			isChanged |= levels[tileIter] != level;
+			levels[tileIter] = level;
+		}
+
+		if (isChanged)
+		{
+			Rebuild();
+		}
+	}
+
+	//counts edge pixels per tile with the table this frame was drawn with. skipped while the last count is still out
+	void CountEdges(const GLuint& edgeTexture, const GLuint& programHandle)
+	{
+		if (readbackFence != nullptr)
+		{
+			return;
+		}
+
+		const GLuint zero = 0;
+		glClearNamedBufferData(countBuffer, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, &zero);
+
+		glState_t::Get().UseProgram(programHandle);
+		glState_t::Get().BindTextureUnit(0, edgeTexture);
+		BindTable(tableBinding);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, countBinding, countBuffer);
+
+		glDispatchCompute((resolution.x + 15) / 16, (resolution.y + 15) / 16, 1);
+
+		//the table can be rebuilt (resize) before the count lands, so remember what the count was taken over
+		for (GLuint tileIter = 0; tileIter < GetNumTiles(); tileIter++)
+		{
+			countedAreas[tileIter] = tiles[tileIter].rect.w * (float)GetTileHeight(tileIter / gridSize.x);
+		}
+
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glCopyNamedBufferSubData(countBuffer, readbackBuffer, 0, 0, sizeof(GLuint) * maxTiles);
+		readbackFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	void BindTable(const GLuint& binding) const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, tableBuffer);
+	}
+
+	const std::array<tile_t, maxTiles>& GetTiles() const
+	{
+		return tiles;
+	}
+
+	GLuint GetNumTiles() const
+	{
+		return gridSize.x * gridSize.y;
+	}
+
+	//the last row (and column) can come up short when the resolution doesn't divide evenly
+	GLint GetTileHeight(const GLuint& row) const
+	{
+		return std::max(std::min(tileSize.y, resolution.y - (GLint)row * tileSize.y), 0);
+	}
+
+	GLint GetTileY(const GLuint& row) const
+	{
+		return (GLint)row * tileSize.y;
+	}
+
+	float GetScale(const GLuint& tileIndex) const
+	{
+		return scaleLevels[levels[tileIndex]];
+	}
+
+	//fraction of the screen's pixels that actually get shaded
+	float GetCoverage() const
+	{
+		float shaded = 0.0f;
+		for (GLuint tileIter = 0; tileIter < GetNumTiles(); tileIter++)
+		{
+			shaded += tiles[tileIter].rect.w * (float)GetTileHeight(tileIter / gridSize.x);
+		}
+		return shaded / std::max((float)(resolution.x * resolution.y), 1.0f);
+	}
+
+	void ShutDown()
+	{
+		if (readbackFence != nullptr)
+		{
+			glDeleteSync(readbackFence);
+			readbackFence = nullptr;
+		}
+
+		if (readbackPtr != nullptr)
+		{
+			glUnmapNamedBuffer(readbackBuffer);
+			readbackPtr = nullptr;
+		}
+
+		const GLuint buffers[] = { tableBuffer, countBuffer, readbackBuffer };
+		glDeleteBuffers(3, buffers);
+		tableBuffer = 0;
+		countBuffer = 0;
+		readbackBuffer = 0;
+	}
+
+	//edge pixels per shaded pixel needed to step up to the next scale
+	std::array<float, 3>						densityThresholds = { 0.01f, 0.03f, 0.08f };
+
+	static constexpr GLuint						tableBinding = 1;
+	static constexpr GLuint						countBinding = 2;
+
+private:
+
+	//packs each row's tiles left to right at their current scale and sends the table over
+	void Rebuild()
+	{
+		for (GLuint row = 0; row < gridSize.y; row++)
+		{
+			float atlasX = 0.0f;
+			for (GLuint column = 0; column < gridSize.x; column++)
+			{
+				const GLuint tileIndex = row * gridSize.x + column;
+				const float screenX = (float)(column * tileSize.x);
+				const float screenWidth = (float)std::max(std::min(tileSize.x, resolution.x - (GLint)column * tileSize.x), 0);
+				const float atlasWidth = std::ceil(screenWidth * GetScale(tileIndex));
+
+				tiles[tileIndex].rect = glm::vec4(screenX, screenWidth, atlasX, atlasWidth);
+				atlasX += atlasWidth;
+			}
+		}
+
+		const glm::uvec4 header = glm::uvec4(gridSize, tileSize);
+		glNamedBufferSubData(tableBuffer, 0, sizeof(glm::uvec4), &header);
+		glNamedBufferSubData(tableBuffer, sizeof(glm::uvec4), sizeof(tile_t) * GetNumTiles(), tiles.data());
+	}
+
+	glm::ivec2									resolution;
+	glm::ivec2									tileSize;
+	std::array<tile_t, maxTiles>				tiles;
+	std::array<uint32_t, maxTiles>				levels;
+	std::array<float, maxTiles>					countedAreas; //shaded pixels per tile when the pending count was taken
+
+	GLuint										tableBuffer;
+	GLuint										countBuffer;
+	GLuint										readbackBuffer;
+	const GLuint*								readbackPtr;
+	GLsync										readbackFence;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+//hands out slot indices for a single producer/single consumer triple buffer. the data itself lives wherever
+//the owner wants (usually a std::array<T, 3> per class) so each class can snapshot its own state.
+//the writer always has a slot to fill, the reader always gets the newest finished one and neither ever waits
+class tripleBuffer_t
+{
+public:
+
+	tripleBuffer_t()
+	{
+		writeSlot = 0;
+		readSlot = 1;
+		readySlot = 2;
+	}
+
+	//writer side. the slot to fill in for the frame being built
+	size_t GetWriteSlot() const
+	{
+		return writeSlot;
+	}
+
+	//writer side. hand the filled slot over and take the old ready one to write into next
+	void Publish()
+	{
+		writeSlot = readySlot.exchange(writeSlot | freshBit, std::memory_order_acq_rel) & ~freshBit;
+	}
+
+	//reader side. swaps in the newest published slot, false if nothing new came in since last time
+	bool AcquireLatest()
+	{
+		if ((readySlot.load(std::memory_order_acquire) & freshBit) == 0)
+		{
+			return false;
+		}
+
+		readSlot = readySlot.exchange(readSlot, std::memory_order_acq_rel) & ~freshBit;
+		return true;
+	}
+
+	bool HasNewFrame() const
+	{
+		return (readySlot.load(std::memory_order_acquire) & freshBit) != 0;
+	}
+
+	//reader side. the slot to read from for the frame being rendered
+	size_t GetReadSlot() const
+	{
+		return readSlot;
+	}
+
+	static constexpr size_t numSlots = 3;
+
+private:
+
+	static constexpr uint32_t freshBit = 0x4;
+
+	uint32_t				writeSlot;
+	uint32_t				readSlot;
+	std::atomic<uint32_t>	readySlot;
+};
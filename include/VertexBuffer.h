@@ -33,7 +33,7 @@ public:
 		const std::vector<unsigned int> indices = { 0, 1, 2, 3, 4, 5 };
 
 		glGenVertexArrays(1, &vertexArrayHandle);
-		glBindVertexArray(vertexArrayHandle);
+		glState_t::Get().BindVertexArray(vertexArrayHandle);
 
 		//load vertex buffer
 		glGenBuffers(1, &bufferHandle);
@@ -68,7 +68,7 @@ public:
 		std::vector<unsigned int> indices = { 0, 1, 2, 3, 4, 5 };
 
 		glGenVertexArrays(1, &vertexArrayHandle);
-		glBindVertexArray(vertexArrayHandle);
+		glState_t::Get().BindVertexArray(vertexArrayHandle);
 
 		//load vertex buffer
 		glGenBuffers(1, &bufferHandle);
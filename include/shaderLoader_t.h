@@ -1,5 +1,27 @@
 #pragma once
 
+//TinyShaders::LoadShader with the source already in memory, so it can come out of the asset pack.
+//keeps its checks and error reporting. shaderFile is only kept for reloading and error messages
+static void LoadShaderFromBuffer(shader_t& outShader, const std::string& name, const std::string& shaderFile, const shaderType_e& shaderType, std::string buffer)
+{
+    if (name.empty())
+    {
+        TinyShaders::AddErrorLog(TinyShaders::error_e::invalidString);
+        return;
+    }
+
+    shader_t newShader = shader_t(name, shaderType, shaderFile);
+    newShader.buffer = std::move(buffer);
+    TinyShaders::CompileShader(newShader);
+
+    if (newShader.isCompiled)
+    {
+        outShader = newShader;
+        return;
+    }
+    TinyShaders::AddErrorLog(TinyShaders::error_e::shaderCompileFailed, &newShader);
+}
+
 //ok here we just need a basic system to load snaders via JSON
 static void LoadShaderProgramsFromConfigFile(tsl::robin_map<std::string, ShaderProgram_t>* outPrograms = nullptr )
 {
@@ -11,30 +33,19 @@ static void LoadShaderProgramsFromConfigFile(tsl::robin_map<std::string, ShaderP
     printf("%s \n", workingDire.string().c_str());
 #endif
 
-    //add the two string together
+    //add the two string together. paths are relative to assets/ so they can come out of the asset pack
     auto fileName = std::string(PROJECT_NAME) + ".json";
-    auto shaderPathPart = workingDire / "assets/shaders/";
+    const std::string shaderPathPart = std::string("shaders/") + PROJECT_NAME + "/";
 
-    auto fullPath = shaderPathPart / PROJECT_NAME / fileName.c_str();
+    const std::string fullPath = shaderPathPart + fileName;
 
-    if (std::filesystem::exists(fullPath) && std::filesystem::is_regular_file(fullPath))
+    //yyjson reads straight out of the pack, no copy
+    const assetFile_t configFile = virtualFileSystem_t::Get().Open(fullPath);
+    if (configFile.IsValid())
     {
-        //first load the json file from JSON into a string
-        FILE* pConfigFile = fopen(fullPath.string().c_str(), "r");
-        fseek(pConfigFile, 0, SEEK_END);
-
-        long fileSize = ftell(pConfigFile);
-
-        fseek(pConfigFile, 0, SEEK_SET);
-
-        std::string tempBuffer;
-        tempBuffer.resize(fileSize);
-        fread(&tempBuffer[0], fileSize, 1, pConfigFile);
-        fclose(pConfigFile);
-
         //now the JSON part
 
-        yyjson_doc* jsonDoc = yyjson_read(tempBuffer.c_str(), tempBuffer.size(), 0);
+        yyjson_doc* jsonDoc = yyjson_read(configFile.GetData(), configFile.GetSize(), 0);
         assert(jsonDoc != nullptr);
 
         yyjson_val* root = yyjson_doc_get_root(jsonDoc);
@@ -118,11 +129,12 @@ static void LoadShaderProgramsFromConfigFile(tsl::robin_map<std::string, ShaderP
                                 printf("loading shader type: %s\n", yyjson_get_str(shaderType));
 #endif
                                 const std::string newPath = std::string( yyjson_get_str(shaderPath));
-                                const std::string localPath = (shaderPathPart / PROJECT_NAME / newPath).string();
+                                const std::string localPath = shaderPathPart + newPath;
                                 shaderType_e localType = StringToShaderType(std::string(yyjson_get_str(shaderType)));
 
-                                //prepend the working directory to path
-                                TinyShaders::LoadShader(localShader, yyjson_get_str(shaderName), localPath, localType);
+                                //the source comes through the asset pack rather than straight off disk
+                                LoadShaderFromBuffer(localShader, yyjson_get_str(shaderName), ASSET_DIR + localPath, localType,
+                                    virtualFileSystem_t::Get().OpenText(localPath));
                             }
 
                             if (localShader.isCompiled == true)
@@ -98,6 +98,53 @@ function scene_project(name, parents)
                     "-Wno-deprecated-enum-enum-conversion", "-Wno-macro-redefined"}
 end
 
+--offline tools. no window or GL, just the CPU side libs
+function tool_project(name)
+    project(name)
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++20"
+
+        toolset "clang"
+        debugdir(_SCRIPT_DIR)
+
+        files {
+            "tools/" .. name .. "/include/**.h",
+            "tools/" .. name .. "/source/**.cpp",
+        }
+
+        includedirs {
+            "include/",
+            "tools/" .. name .. "/include/",
+            "lib/glm/",
+            "lib/gli/",
+            "lib/stb/",
+        }
+
+        defines {
+            "ASSET_DIR=\"" .. _SCRIPT_DIR .. "/assets/\"",
+        }
+
+        filter { "system:windows" }
+            systemversion "latest"
+
+        filter { "system:linux" }
+            links { "pthread" }
+
+        filter { "configurations:Debug" }
+            defines { "DEBUG" }
+            symbols "on"
+            optimize "Off"
+            targetdir (_SCRIPT_DIR .. "/bin/Debug")
+
+        filter { "configurations:Release" }
+            optimize "on"
+            symbols "off"
+            targetdir (_SCRIPT_DIR .. "/bin/Release")
+
+        filter {}
+end
+
 if os.host() == "linux" then
     location "proj/cmake"
     else if os.host() == "windows" then
@@ -134,4 +181,9 @@ scene_project("scene")
 scene_project("scene3D")
 --anti aliasing projects
 scene_project("SMAA", {"scene3D", "texturedScene3D"})
-scene_project("OAUpsampler", {"scene3D", "texturedScene3D", "SMAA"})
\ No newline at end of file
+scene_project("OAUpsampler", {"scene3D", "texturedScene3D", "SMAA"})
+--stress tests
+scene_project("instancedStress", {"scene3D", "texturedScene3D", "SMAA", "OAUpsampler"})
+--tools
+tool_project("textureCooker")
+tool_project("assetPacker")
\ No newline at end of file
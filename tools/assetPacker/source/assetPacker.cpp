@@ -0,0 +1,152 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+#include "AssetPack.h"
+
+//bundles the files a project reads at startup into assets/packs/<project>.pak, which the project mounts through
+//virtualFileSystem_t. anything left out still loads as a loose file, so the pack only has to cover the hot paths
+//
+//usage: assetPacker <project> [extra paths relative to assets/...]
+//defaults to shaders/<project>, textures/SMAA and cooked/
+
+struct packSource_t
+{
+	std::string		path;
+	uint64_t		hash;
+	uint64_t		size;
+};
+
+static uint64_t AlignUp(const uint64_t& value)
+{
+	return (value + assetPackHeader_t::alignment - 1) & ~(assetPackHeader_t::alignment - 1);
+}
+
+static void Gather(const std::filesystem::path& assetDir, const std::string& root, std::vector<packSource_t>& sources)
+{
+	const std::filesystem::path rootPath = assetDir / root;
+	const auto addFile = [&](const std::filesystem::path& filePath)
+	{
+		const std::string relativePath = std::filesystem::relative(filePath, assetDir).generic_string();
+		sources.push_back({ relativePath, HashAssetPath(relativePath), (uint64_t)std::filesystem::file_size(filePath) });
+	};
+
+	if (std::filesystem::is_regular_file(rootPath))
+	{
+		addFile(rootPath);
+		return;
+	}
+
+	if (!std::filesystem::is_directory(rootPath))
+	{
+		printf("couldn't find: %s \n", rootPath.string().c_str());
+		return;
+	}
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(rootPath))
+	{
+		if (entry.is_regular_file() && *std::filesystem::relative(entry.path(), assetDir).begin() != "packs")
+		{
+			addFile(entry.path());
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		printf("usage: assetPacker <project> [extra paths relative to assets/...] \n");
+		return 1;
+	}
+
+	const std::filesystem::path assetDir = ASSET_DIR;
+	const std::string projectName = argv[1];
+
+	std::vector<std::string> roots = { "shaders/" + projectName, "textures/SMAA", "cooked" };
+	for (int iter = 2; iter < argc; iter++)
+	{
+		roots.emplace_back(argv[iter]);
+	}
+
+	std::vector<packSource_t> sources;
+	for (const auto& root : roots)
+	{
+		Gather(assetDir, root, sources);
+	}
+
+	//roots can overlap, and the table gets searched by hash
+	std::ranges::sort(sources, [](const packSource_t& lhs, const packSource_t& rhs) { return std::tie(lhs.hash, lhs.path) < std::tie(rhs.hash, rhs.path); });
+	sources.erase(std::unique(sources.begin(), sources.end(), [](const packSource_t& lhs, const packSource_t& rhs) { return lhs.path == rhs.path; }), sources.end());
+
+	assetPackHeader_t header;
+	header.numEntries = (uint32_t)sources.size();
+
+	std::vector<assetPackEntry_t> entries;
+	std::string paths;
+	for (const auto& source : sources)
+	{
+		entries.push_back({ source.hash, 0, source.size, (uint32_t)paths.size(), (uint32_t)source.path.size() });
+		paths += source.path;
+	}
+	header.pathBytes = (uint32_t)paths.size();
+
+	uint64_t offset = AlignUp(sizeof(assetPackHeader_t) + sizeof(assetPackEntry_t) * entries.size() + paths.size());
+	for (auto& entry : entries)
+	{
+		entry.offset = offset;
+		offset = AlignUp(offset + entry.size);
+	}
+
+	//written next to the old pack and swapped in at the end, so a running project never sees half a file
+	const std::filesystem::path packPath = assetDir / "packs" / (projectName + ".pak");
+	const std::filesystem::path tempPath = std::filesystem::path(packPath).replace_extension(".tmp");
+	std::filesystem::create_directories(packPath.parent_path());
+
+	std::ofstream pack(tempPath, std::ios::binary | std::ios::trunc);
+	if (!pack)
+	{
+		printf("couldn't write: %s \n", tempPath.string().c_str());
+		return 1;
+	}
+
+	pack.write((const char*)&header, sizeof(header));
+	pack.write((const char*)entries.data(), (std::streamsize)(sizeof(assetPackEntry_t) * entries.size()));
+	pack.write(paths.data(), (std::streamsize)paths.size());
+
+	std::vector<char> buffer;
+	int numFailed = 0;
+	for (size_t iter = 0; iter < sources.size(); iter++)
+	{
+		std::ifstream source(assetDir / sources[iter].path, std::ios::binary);
+		buffer.resize(sources[iter].size);
+		if (!source.read(buffer.data(), (std::streamsize)buffer.size()))
+		{
+			printf("couldn't read: %s \n", sources[iter].path.c_str());
+			std::ranges::fill(buffer, 0);
+			numFailed++;
+		}
+
+		//pad up to the entry's page
+		const std::vector<char> padding(entries[iter].offset - (uint64_t)pack.tellp(), 0);
+		pack.write(padding.data(), (std::streamsize)padding.size());
+		pack.write(buffer.data(), (std::streamsize)buffer.size());
+	}
+	pack.close();
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, packPath, error);
+	if (error)
+	{
+		printf("couldn't replace: %s \n", packPath.string().c_str());
+		return 1;
+	}
+
+	printf("packed %zu files (%llu bytes) into %s, %i failed \n", sources.size(), (unsigned long long)offset, packPath.generic_string().c_str(), numFailed);
+	return numFailed == 0 ? 0 : 1;
+}
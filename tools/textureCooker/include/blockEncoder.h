@@ -0,0 +1,168 @@
+#pragma once
+
+//small CPU block compressors for the texture cooker. not trying to compete with the big offline encoders,
+//just a principal axis fit for the colour endpoints and a min/max fit for the single channel blocks
+
+using rgba8_t = glm::u8vec4;
+
+namespace blockEncoder
+{
+	//pack a 0-255 colour into 5:6:5
+	inline uint16_t To565(const glm::vec3& color)
+	{
+		const glm::ivec3 quantized = glm::ivec3(glm::round(glm::clamp(color, 0.0f, 255.0f) * glm::vec3(31.0f, 63.0f, 31.0f) / 255.0f));
+		return (uint16_t)((quantized.r << 11) | (quantized.g << 5) | quantized.b);
+	}
+
+	//and back out again the same way a GPU would expand it
+	inline glm::vec3 From565(const uint16_t& color)
+	{
+		const int r = (color >> 11) & 31;
+		const int g = (color >> 5) & 63;
+		const int b = color & 31;
+		return glm::vec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+	}
+
+	//BC1 colour block. always uses 4 colour mode so it can double as the colour half of BC3
+	inline void EncodeBC1(const rgba8_t block[16], uint8_t* out)
+	{
+		glm::vec3 mean(0.0f);
+		for (int iter = 0; iter < 16; iter++)
+		{
+			mean += glm::vec3(block[iter]);
+		}
+		mean /= 16.0f;
+
+		//covariance, then a few rounds of power iteration to find the axis the colours spread along
+		glm::mat3 covariance(0.0f);
+		for (int iter = 0; iter < 16; iter++)
+		{
+			const glm::vec3 delta = glm::vec3(block[iter]) - mean;
+			covariance += glm::outerProduct(delta, delta);
+		}
+
+		glm::vec3 axis(1.0f, 1.0f, 1.0f);
+		for (int iter = 0; iter < 8; iter++)
+		{
+			axis = covariance * axis;
+			const float length = glm::length(axis);
+			if (length < 1e-6f)
+			{
+				break;
+			}
+			axis /= length;
+		}
+
+		float minProjection = FLT_MAX;
+		float maxProjection = -FLT_MAX;
+		for (int iter = 0; iter < 16; iter++)
+		{
+			const float projection = glm::dot(glm::vec3(block[iter]) - mean, axis);
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		//pull the endpoints in a little, the extremes are usually outliers
+		const float inset = (maxProjection - minProjection) / 16.0f;
+		uint16_t color0 = To565(mean + axis * (maxProjection - inset));
+		uint16_t color1 = To565(mean + axis * (minProjection + inset));
+
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+		}
+
+		uint32_t indices = 0;
+		if (color0 != color1)
+		{
+			const glm::vec3 end0 = From565(color0);
+			const glm::vec3 end1 = From565(color1);
+			const glm::vec3 palette[4] = { end0, end1, (end0 * 2.0f + end1) / 3.0f, (end0 + end1 * 2.0f) / 3.0f };
+
+			for (int iter = 0; iter < 16; iter++)
+			{
+				const glm::vec3 color = glm::vec3(block[iter]);
+				uint32_t bestIndex = 0;
+				float bestDistance = FLT_MAX;
+				for (uint32_t paletteIter = 0; paletteIter < 4; paletteIter++)
+				{
+					const glm::vec3 delta = color - palette[paletteIter];
+					const float distance = glm::dot(delta, delta);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = paletteIter;
+					}
+				}
+				indices |= bestIndex << (iter * 2);
+			}
+		}
+
+		memcpy(out, &color0, 2);
+		memcpy(out + 2, &color1, 2);
+		memcpy(out + 4, &indices, 4);
+	}
+
+	//BC4 style single channel block. used for BC3 alpha and both halves of BC5
+	inline void EncodeBC4(const rgba8_t block[16], const int& channel, uint8_t* out)
+	{
+		uint8_t minValue = 255;
+		uint8_t maxValue = 0;
+		for (int iter = 0; iter < 16; iter++)
+		{
+			minValue = std::min(minValue, block[iter][channel]);
+			maxValue = std::max(maxValue, block[iter][channel]);
+		}
+
+		//8 value mode needs end0 > end1
+		out[0] = maxValue;
+		out[1] = minValue;
+
+		uint64_t indices = 0;
+		if (maxValue != minValue)
+		{
+			float palette[8];
+			palette[0] = maxValue;
+			palette[1] = minValue;
+			for (int iter = 1; iter < 7; iter++)
+			{
+				palette[iter + 1] = ((7 - iter) * (float)maxValue + iter * (float)minValue) / 7.0f;
+			}
+
+			for (int iter = 0; iter < 16; iter++)
+			{
+				const float value = block[iter][channel];
+				uint64_t bestIndex = 0;
+				float bestDistance = FLT_MAX;
+				for (uint64_t paletteIter = 0; paletteIter < 8; paletteIter++)
+				{
+					const float distance = std::abs(value - palette[paletteIter]);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = paletteIter;
+					}
+				}
+				indices |= bestIndex << (iter * 3);
+			}
+		}
+
+		//48 bits of 3 bit indices, little endian
+		for (int iter = 0; iter < 6; iter++)
+		{
+			out[2 + iter] = (uint8_t)(indices >> (iter * 8));
+		}
+	}
+
+	inline void EncodeBC3(const rgba8_t block[16], uint8_t* out)
+	{
+		EncodeBC4(block, 3, out);
+		EncodeBC1(block, out + 8);
+	}
+
+	inline void EncodeBC5(const rgba8_t block[16], uint8_t* out)
+	{
+		EncodeBC4(block, 0, out);
+		EncodeBC4(block, 1, out + 8);
+	}
+}
@@ -0,0 +1,249 @@
+#define STB_IMAGE_IMPLEMENTATION
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <cstdio>
+#include <cfloat>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <functional>
+#include <atomic>
+#include <glm/glm.hpp>
+#include <gli/gli.hpp>
+#include <stb_image.h>
+
+#include "ThreadPool.h"
+#include "blockEncoder.h"
+
+//cooks source images into block compressed dds files with full mip chains.
+//output mirrors the input under assets/cooked/ which is where texture::DecodeImage looks first.
+//images are stored bottom row first (same as stb with flipping on) so the runtime can skip the flip
+//
+//usage: textureCooker [paths relative to assets/...]. defaults to everything under models/
+
+enum class cookType_t
+{
+	albedo,
+	albedoAlpha,
+	normal
+};
+
+using mipLevel_t = std::vector<rgba8_t>;
+
+static bool IsImage(const std::filesystem::path& path)
+{
+	std::string extension = path.extension().string();
+	std::ranges::transform(extension, extension.begin(), [](const unsigned char c) { return (char)std::tolower(c); });
+	return extension == ".tga" || extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp" || extension == ".psd";
+}
+
+static bool IsNormalMap(const std::filesystem::path& path)
+{
+	std::string name = path.stem().string();
+	std::ranges::transform(name, name.begin(), [](const unsigned char c) { return (char)std::tolower(c); });
+	return name.ends_with("_nrm") || name.ends_with("_normal") || name.ends_with("_n") || name.ends_with("_norm");
+}
+
+//2x2 box filter. normal maps get renormalized instead of just averaged
+static mipLevel_t Downsample(const mipLevel_t& source, const glm::ivec2& sourceSize, const glm::ivec2& destSize, const bool& isNormal)
+{
+	mipLevel_t dest(destSize.x * destSize.y);
+	for (int y = 0; y < destSize.y; y++)
+	{
+		for (int x = 0; x < destSize.x; x++)
+		{
+			glm::vec4 sum(0.0f);
+			for (int offset = 0; offset < 4; offset++)
+			{
+				const int sourceX = std::min(x * 2 + (offset & 1), sourceSize.x - 1);
+				const int sourceY = std::min(y * 2 + (offset >> 1), sourceSize.y - 1);
+				sum += glm::vec4(source[sourceY * sourceSize.x + sourceX]);
+			}
+			glm::vec4 result = sum * 0.25f;
+
+			if (isNormal)
+			{
+				glm::vec3 normal = glm::vec3(result) / 127.5f - 1.0f;
+				normal = glm::length(normal) > 1e-6f ? glm::normalize(normal) : glm::vec3(0.0f, 0.0f, 1.0f);
+				result = glm::vec4((normal + 1.0f) * 127.5f, result.a);
+			}
+
+			dest[y * destSize.x + x] = rgba8_t(glm::round(glm::clamp(result, 0.0f, 255.0f)));
+		}
+	}
+	return dest;
+}
+
+static void CompressLevel(const mipLevel_t& pixels, const glm::ivec2& size, const cookType_t& cookType, uint8_t* out)
+{
+	const int blockBytes = (cookType == cookType_t::albedo) ? 8 : 16;
+	const int blocksWide = (size.x + 3) / 4;
+	const int blocksHigh = (size.y + 3) / 4;
+
+	rgba8_t block[16];
+	for (int blockY = 0; blockY < blocksHigh; blockY++)
+	{
+		for (int blockX = 0; blockX < blocksWide; blockX++)
+		{
+			//clamp at the edges for levels smaller than a block
+			for (int iter = 0; iter < 16; iter++)
+			{
+				const int x = std::min(blockX * 4 + (iter & 3), size.x - 1);
+				const int y = std::min(blockY * 4 + (iter >> 2), size.y - 1);
+				block[iter] = pixels[y * size.x + x];
+			}
+
+			uint8_t* blockOut = out + (blockY * blocksWide + blockX) * blockBytes;
+			switch (cookType)
+			{
+				case cookType_t::albedo: blockEncoder::EncodeBC1(block, blockOut); break;
+				case cookType_t::albedoAlpha: blockEncoder::EncodeBC3(block, blockOut); break;
+				case cookType_t::normal: blockEncoder::EncodeBC5(block, blockOut); break;
+			}
+		}
+	}
+}
+
+static bool CookTexture(const std::filesystem::path& assetDir, const std::filesystem::path& relativePath)
+{
+	const std::filesystem::path sourcePath = assetDir / relativePath;
+	const std::filesystem::path cookedPath = assetDir / "cooked" / std::filesystem::path(relativePath).replace_extension(".dds");
+
+	//skip anything that's already up to date
+	if (std::filesystem::exists(cookedPath) && std::filesystem::last_write_time(cookedPath) >= std::filesystem::last_write_time(sourcePath))
+	{
+		printf("up to date: %s \n", relativePath.generic_string().c_str());
+		return true;
+	}
+
+	glm::ivec2 size(0);
+	int channels = 0;
+	stbi_uc* data = stbi_load(sourcePath.string().c_str(), &size.x, &size.y, &channels, 4);
+	if (data == nullptr)
+	{
+		printf("couldn't load texture: %s \n", sourcePath.string().c_str());
+		return false;
+	}
+
+	//flip to bottom row first while copying in
+	mipLevel_t baseLevel(size.x * size.y);
+	bool hasAlpha = false;
+	for (int y = 0; y < size.y; y++)
+	{
+		const rgba8_t* sourceRow = (const rgba8_t*)data + (size.y - 1 - y) * size.x;
+		std::copy_n(sourceRow, size.x, baseLevel.begin() + y * size.x);
+	}
+	stbi_image_free(data);
+
+	for (const auto& pixel : baseLevel)
+	{
+		hasAlpha |= (pixel.a < 255);
+	}
+
+	cookType_t cookType = cookType_t::albedo;
+	gli::format format = gli::FORMAT_RGB_DXT1_UNORM_BLOCK8;
+	if (IsNormalMap(relativePath))
+	{
+		cookType = cookType_t::normal;
+		format = gli::FORMAT_RG_ATI2N_UNORM_BLOCK16;
+	}
+
+	else if (hasAlpha)
+	{
+		cookType = cookType_t::albedoAlpha;
+		format = gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16;
+	}
+
+	const gli::extent2d extent(size.x, size.y);
+	gli::texture2d cooked(format, extent, gli::levels(extent));
+
+	mipLevel_t level = std::move(baseLevel);
+	glm::ivec2 levelSize = size;
+	for (size_t levelIter = 0; levelIter < cooked.levels(); levelIter++)
+	{
+		CompressLevel(level, levelSize, cookType, (uint8_t*)cooked.data(0, 0, levelIter));
+
+		if (levelIter + 1 < cooked.levels())
+		{
+			const glm::ivec2 nextSize = glm::max(levelSize / 2, glm::ivec2(1));
+			level = Downsample(level, levelSize, nextSize, cookType == cookType_t::normal);
+			levelSize = nextSize;
+		}
+	}
+
+	std::filesystem::create_directories(cookedPath.parent_path());
+	if (!gli::save_dds(cooked, cookedPath.string()))
+	{
+		printf("couldn't save texture: %s \n", cookedPath.string().c_str());
+		return false;
+	}
+
+	const char* typeNames[] = { "BC1", "BC3", "BC5" };
+	printf("cooked %s -> %s (%s, %zu levels) \n", relativePath.generic_string().c_str(), cookedPath.generic_string().c_str(), typeNames[(int)cookType], cooked.levels());
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	const std::filesystem::path assetDir = ASSET_DIR;
+
+	std::vector<std::string> roots;
+	for (int iter = 1; iter < argc; iter++)
+	{
+		roots.emplace_back(argv[iter]);
+	}
+
+	if (roots.empty())
+	{
+		roots.emplace_back("models");
+	}
+
+	//gather every source image, skipping our own output
+	std::vector<std::filesystem::path> sources;
+	for (const auto& root : roots)
+	{
+		const std::filesystem::path rootPath = assetDir / root;
+		if (std::filesystem::is_regular_file(rootPath))
+		{
+			sources.push_back(std::filesystem::path(root));
+			continue;
+		}
+
+		if (!std::filesystem::is_directory(rootPath))
+		{
+			printf("couldn't find: %s \n", rootPath.string().c_str());
+			continue;
+		}
+
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(rootPath))
+		{
+			const std::filesystem::path relativePath = std::filesystem::relative(entry.path(), assetDir);
+			if (entry.is_regular_file() && IsImage(entry.path()) && *relativePath.begin() != "cooked")
+			{
+				sources.push_back(relativePath);
+			}
+		}
+	}
+
+	std::vector<std::future<bool>> jobs;
+	for (const auto& source : sources)
+	{
+		jobs.push_back(threadPool_t::Get().Enqueue([&assetDir, source]() { return CookTexture(assetDir, source); }));
+	}
+
+	int numFailed = 0;
+	for (auto& job : jobs)
+	{
+		numFailed += job.get() ? 0 : 1;
+	}
+
+	printf("%zu textures, %i failed \n", sources.size(), numFailed);
+	return numFailed == 0 ? 0 : 1;
+}